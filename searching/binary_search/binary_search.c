@@ -10,23 +10,129 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <time.h>
 #include "ansi_colors.h" // Include ANSI color codes for console output (custom header file)
+#include "array_file.h" // Binary and line-delimited array files for `--in` (custom header file)
+#include "text_reader.h" // Buffered `read()` input with a SWAR number parser for the prompts (custom header file)
+#include "index_file.h" // Sorted arrays saved once and searched straight from `mmap()` (custom header file)
 
 #define STRING_LENGTH 50
+#define CACHE_LINE 64 // Bytes per cache line: alignment of the Eytzinger keys
+#define EYTZINGER_PREFETCH (CACHE_LINE / 4) // Descendants 4 levels down of one 4-byte key share a cache line
+#define DEFAULT_BENCHMARK_SIZE (1 << 24) // Largest array of `--benchmark` without an argument (64 MB of ints)
+#define BENCHMARK_LOOKUPS (1 << 20) // Random targets looked up per benchmark cell
+#define BATCH_GROUP 32 // Searches of a batch advanced in lockstep, so their cache misses overlap
+#define MODE_BENCHMARK_FRONT 256 // "front" targets of `--mode-benchmark` are among the first this many keys
+#define AUTO_SAMPLES 64 // Evenly spaced keys `--mode auto` compares with a straight line from the first to the last key
+#define AUTO_MAX_ERROR 0.01 // Largest sampled deviation from that line (fraction of the array) for which auto picks interp
+
+// How a sorted int or float array is searched (`--mode`); strings and characters always use `binary_search()`
+typedef enum { MODE_BINARY, MODE_BRANCHLESS, MODE_EYTZINGER, MODE_INTERP, MODE_EXP, MODE_AUTO, MODE_COUNT } search_mode_t;
+const char *mode_names[MODE_COUNT] = {"binary", "branchless", "eytzinger", "interp", "exp", "auto"};
+
+// Static search index: the sorted keys re-laid in Eytzinger (BFS) order, the root at 1, the children of k at 2k and 2k + 1
+typedef struct {
+    char type;     // 'i' or 'f'
+    int size;
+    int32_t *keys; // size + 1 slots (slot 0 unused), `CACHE_LINE`-aligned; ints and floats are stored as their 32 bits
+    int *rank;     // rank[k]: index in the sorted array of keys[k]
+} eytzinger_t;
+
+// How `search_batch()` answered a batch
+typedef enum { BATCH_INTERLEAVED, BATCH_SORTED, BATCH_ONE_BY_ONE } batch_path_t;
+const char *batch_path_names[] = {"interleaved", "sorted queries", "one by one"};
+
+search_mode_t search_mode = MODE_BINARY; // Search implementation for ints and floats (`--mode`)
+int mode_chosen = 0; // Whether `--mode` was given; without it `--queries` go to the batched search
+long long probe_count = 0; // Array elements read by `binary_search()`, `interpolation_search()` and `exponential_search()`
 
 int binary_search(void *arr, int size, char type, void *target, int visualize);
+int binary_search_branchless(void *arr, int size, char type, void *target);
+int eytzinger_build(eytzinger_t *index, void *arr, int size, char type);
+int eytzinger_fill(const int32_t *sorted, eytzinger_t *index, int next, size_t k);
+int eytzinger_search(const eytzinger_t *index, void *target);
+void eytzinger_free(eytzinger_t *index);
+int interpolation_search(void *arr, int size, char type, void *target);
+int exponential_search(void *arr, int size, char type, void *target, int hint);
+search_mode_t auto_search_mode(void *arr, int size, char type);
+search_mode_t resolve_search_mode(void *arr, int size, char type, search_mode_t requested);
+int search_with_mode(void *arr, int size, char type, void *target, search_mode_t mode, int visualize);
+int mode_counts_probes(char type, search_mode_t mode);
+void mode_label(char *label, search_mode_t requested, search_mode_t mode);
+int search_queries(void *arr, int size, char type, const eytzinger_t *index, const void *targets, int count, int *results, char *label);
+batch_path_t search_batch(void *arr, int size, char type, const void *targets, int count, int *results);
+void run_benchmark(int max_size);
+void run_batch_benchmark(int size);
+void run_mode_benchmark(int size);
+int compare_int(const void *a, const void *b);
+int compare_float(const void *a, const void *b);
+int compare_char(const void *a, const void *b);
+int compare_string(const void *a, const void *b);
+int parse_target(char type, const char *text, char *target);
+char *lines_to_rows(char **lines, int count, const char *what);
+double now_seconds(void);
 void print_array(void *arr, int size, char type);
 void print_array_with_range(void *arr, int size, char type, int left, int right, int mid);
+int array_is_sorted(void *arr, int size, char type);
 void sort_array(void *arr, int size, char type);
+int search_array_file(const char *input_path, const char *format, const char *target_text, const char *queries_path);
+int build_index_file(const char *input_path, const char *format, const char *index_path);
+int search_index_file(const char *index_path, const char *target_text, const char *queries_path);
 
 int main(int argc, char *argv[]) {
     int visualize = 0;
-    if (argc > 1) if (strcmp(argv[1], "-v") == 0 || strcmp(argv[1], "--visualize") == 0) visualize = 1; // Enable visualization if -v or --visualize is passed
+    int benchmark_size = 0, batch_benchmark_size = 0, mode_benchmark_size = 0;
+    const char *input_path = NULL, *format = NULL, *target_text = NULL, *queries_path = NULL;
+    const char *build_index_path = NULL, *index_path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0 || strcmp(argv[i], "--visualize") == 0) visualize = 1; // Enable visualization if -v or --visualize is passed
+        else if (strcmp(argv[i], "--in") == 0 && i + 1 < argc) input_path = argv[++i]; // Search an array file instead of prompting (needs --format and --target)
+        else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) format = argv[++i]; // Array file format: i32, f32, u8 or lines
+        else if (strcmp(argv[i], "--target") == 0 && i + 1 < argc) target_text = argv[++i]; // Value to search for in the --in file
+        else if (strcmp(argv[i], "--queries") == 0 && i + 1 < argc) queries_path = argv[++i]; // File of targets (same format as --in), searched as one batch
+        else if (strcmp(argv[i], "--build-index") == 0 && i + 1 < argc) build_index_path = argv[++i]; // Sort the --in file once and save it as an index file
+        else if (strcmp(argv[i], "--index") == 0 && i + 1 < argc) index_path = argv[++i]; // Search a saved index file (needs --target or --queries)
+        else if (strcmp(argv[i], "--mode") == 0 && i + 1 < argc) { // Search implementation: binary, branchless, eytzinger, interp, exp or auto
+            const char *name = argv[++i];
+            int mode = 0;
+            while (mode < MODE_COUNT && strcmp(name, mode_names[mode]) != 0) mode++;
+            if (mode == MODE_COUNT) {
+                fprintf(stderr, "--mode needs binary, branchless, eytzinger, interp, exp or auto!\n");
+                return 1;
+            }
+            search_mode = mode;
+            mode_chosen = 1;
+        }
+        else if (strcmp(argv[i], "--benchmark") == 0) benchmark_size = i + 1 < argc && atoi(argv[i + 1]) > 0 ? atoi(argv[++i]) : DEFAULT_BENCHMARK_SIZE; // Lookups per second of binary, branchless and eytzinger
+        else if (strcmp(argv[i], "--batch-benchmark") == 0) batch_benchmark_size = i + 1 < argc && atoi(argv[i + 1]) > 0 ? atoi(argv[++i]) : DEFAULT_BENCHMARK_SIZE; // Batched lookups per second
+        else if (strcmp(argv[i], "--mode-benchmark") == 0) mode_benchmark_size = i + 1 < argc && atoi(argv[i + 1]) > 0 ? atoi(argv[++i]) : DEFAULT_BENCHMARK_SIZE; // Probes and lookups per second of binary, interp, exp and auto
+    }
+
+    if (input_path && build_index_path) return build_index_file(input_path, format, build_index_path);
+    if (index_path) return search_index_file(index_path, target_text, queries_path);
+    if (input_path) return search_array_file(input_path, format, target_text, queries_path);
+
+    if (benchmark_size > 0) {
+        run_benchmark(benchmark_size);
+        return 0;
+    }
+    if (batch_benchmark_size > 0) {
+        run_batch_benchmark(batch_benchmark_size);
+        return 0;
+    }
+    if (mode_benchmark_size > 0) {
+        run_mode_benchmark(mode_benchmark_size);
+        return 0;
+    }
 
+    setvbuf(stdin, NULL, _IONBF, 0); // The number prompts read stdin with `read()` (text_reader.h), so stdio must not read ahead
     int choice;
     printf(MAGENTA "Binary Search\n");
     printf("=============\n" RESET);
     if (visualize) printf(BG_YELLOW "Visualization enabled." RESET "\n");
+    if (search_mode != MODE_BINARY) printf(BG_YELLOW "Search mode: %s." RESET "\n", mode_names[search_mode]);
+    if (search_mode != MODE_BINARY && visualize) printf(YELLOW "Only the binary mode is visualized, using it.\n" RESET);
     printf("Choose data type:\n");
     printf("1. Integers\n");
     printf("2. Floats\n");
@@ -50,12 +156,15 @@ int main(int argc, char *argv[]) {
             arr = malloc(size * sizeof(int));
             target = malloc(sizeof(int));
 
+            text_reader_t reader;
+            text_reader_open(&reader, STDIN_FILENO);
             printf("Enter %d integers: ", size);
-            for (int i = 0; i < size; i++) scanf("%*[^0-9]%d", &((int*)arr)[i]);
-            while (getchar() != '\n'); // Clear input buffer
+            for (int i = 0; i < size; i++) text_reader_int(&reader, &((int*)arr)[i]);
+            text_reader_skip_line(&reader); // Clear input buffer
 
             printf("Enter target integer: ");
-            scanf("%d", (int*) target);
+            text_reader_int(&reader, (int*) target);
+            text_reader_close(&reader);
             break;
         }
         // For floats
@@ -64,12 +173,15 @@ int main(int argc, char *argv[]) {
             arr = malloc(size * sizeof(float));
             target = malloc(sizeof(float));
 
+            text_reader_t reader;
+            text_reader_open(&reader, STDIN_FILENO);
             printf("Enter %d floats: ", size);
-            for (int i = 0; i < size; i++) scanf("%*[^0-9.]%f", &((float*)arr)[i]);
-            while (getchar() != '\n'); // Clear input buffer
+            for (int i = 0; i < size; i++) text_reader_float(&reader, &((float*)arr)[i]);
+            text_reader_skip_line(&reader); // Clear input buffer
 
             printf("Enter target float: ");
-            scanf("%f", (float*) target);
+            text_reader_float(&reader, (float*) target);
+            text_reader_close(&reader);
             break;
         }
         // For characters
@@ -112,13 +224,22 @@ int main(int argc, char *argv[]) {
     print_array(arr, size, type);
     printf(RESET);
 
-    sort_array(arr, size, type);
+    double start = now_seconds();
+    int sorted = array_is_sorted(arr, size, type);
+    double check_time = now_seconds() - start;
+    start = now_seconds();
+    if (!sorted) sort_array(arr, size, type);
+    double sort_time = now_seconds() - start;
     printf("Sorted Array: " DIM);
     print_array(arr, size, type);
     printf(RESET);
+    printf(DIM "Check %.6f s, sort %.6f s%s\n" RESET, check_time, sort_time, sorted ? " (already sorted, skipped)" : "");
 
     printf(CYAN "\n-- Binary Search --\n" RESET);
-    int result = binary_search(arr, size, type, target, visualize);
+    start = now_seconds();
+    search_mode_t mode = visualize ? MODE_BINARY : resolve_search_mode(arr, size, type, search_mode);
+    int result = search_with_mode(arr, size, type, target, mode, visualize);
+    double search_time = now_seconds() - start;
 
     switch (type) {
         case 'i':
@@ -151,6 +272,11 @@ int main(int argc, char *argv[]) {
             else
                 printf(RED "Element not found\n" RESET);
     }
+    char label[32];
+    mode_label(label, visualize ? MODE_BINARY : search_mode, mode);
+    printf(DIM "Search %.6f s (%s", search_time, label);
+    if (mode_counts_probes(type, mode)) printf(", %lld probes", probe_count);
+    printf(")\n" RESET);
 
     free(arr);
     free(target);
@@ -181,6 +307,7 @@ int binary_search(void *arr, int size, char type, void *target, int visualize) {
     while (start <= end) {
         int mid = start + (end - start) / 2;
         int cmp = 0;
+        probe_count++;
 
         if (visualize) {
             printf("Step %d: mid=%d (%d-%d) -> ", step++, mid, start, end);
@@ -189,7 +316,7 @@ int binary_search(void *arr, int size, char type, void *target, int visualize) {
 
         switch (type) {
             case 'i': // Integer
-                cmp = ((int*)arr)[mid] - *(int*)target;
+                cmp = (((int*)arr)[mid] > *(int*)target) - (((int*)arr)[mid] < *(int*)target); // `a - b` overflows for far-apart ints
                 break;
             case 'f': // Float
                 if (((float*)arr)[mid] < *(float*)target) cmp = -1;
@@ -216,6 +343,1006 @@ int binary_search(void *arr, int size, char type, void *target, int visualize) {
     return -1; // Element not found
 }
 
+// Branchless, Eytzinger, batch, interpolation and exponential search kernels, one per element type
+#define DEFINE_SEARCH_KERNELS(name, T)                                                                                          \
+/* Index of the first element >= target (size if none). The halving step is a conditional move, not a branch, */               \
+/* and both possible next midpoints are prefetched, so the next probe's cache miss overlaps this one. */                       \
+int name##_lower_bound(const T *arr, int size, T target) {                                                                      \
+    if (size <= 0) return 0;                                                                                                    \
+    const T *base = arr;                                                                                                        \
+    int n = size;                                                                                                               \
+    while (n > 1) {                                                                                                             \
+        int half = n / 2;                                                                                                       \
+        __builtin_prefetch(base + half / 2);                                                                                    \
+        __builtin_prefetch(base + half + half / 2);                                                                             \
+        base = base[half] < target ? base + half : base;                                                                        \
+        n -= half;                                                                                                              \
+    }                                                                                                                           \
+    return (int)(base - arr) + (*base < target);                                                                                \
+}                                                                                                                               \
+                                                                                                                                \
+/* Eytzinger slot of the first key >= target (0 if none): descend with k = 2k + (key < target), prefetching the */             \
+/* cache line that holds all 16 descendants 4 levels down; the trailing 1-bits of k are the right turns */                     \
+/* taken after the last left turn, so shifting them out (and the 0 before them) lands on the answer. */                        \
+size_t name##_eytzinger_lower_bound(const T *keys, int size, T target) {                                                        \
+    size_t k = 1;                                                                                                               \
+    while (k <= (size_t)size) {                                                                                                 \
+        __builtin_prefetch(keys + k * EYTZINGER_PREFETCH);                                                                      \
+        k = 2 * k + (keys[k] < target);                                                                                         \
+    }                                                                                                                           \
+    return k >> __builtin_ffsll((long long)~k);                                                                                 \
+}                                                                                                                               \
+                                                                                                                                \
+/* Lower bounds of a batch of targets. `BATCH_GROUP` searches advance in lockstep: they share the array length, so they */      \
+/* take the same number of halving steps, and the probes of one step are independent loads in flight together. */               \
+/* Every search prefetches its own next midpoint as soon as it is known. */                                                     \
+void name##_lower_bound_batch(const T *arr, int size, const T *targets, int count, int *results) {                              \
+    for (int first = 0; first < count; first += BATCH_GROUP) {                                                                  \
+        int group = count - first < BATCH_GROUP ? count - first : BATCH_GROUP;                                                  \
+        const T *base[BATCH_GROUP];                                                                                             \
+        for (int g = 0; g < group; g++) base[g] = arr;                                                                          \
+                                                                                                                                \
+        int n = size;                                                                                                           \
+        while (n > 1) {                                                                                                         \
+            int half = n / 2;                                                                                                   \
+            for (int g = 0; g < group; g++) {                                                                                   \
+                base[g] = base[g][half] < targets[first + g] ? base[g] + half : base[g];                                        \
+                __builtin_prefetch(base[g] + (n - half) / 2);                                                                   \
+            }                                                                                                                   \
+            n -= half;                                                                                                          \
+        }                                                                                                                       \
+        for (int g = 0; g < group; g++)                                                                                         \
+            results[first + g] = size > 0 ? (int)(base[g] - arr) + (*base[g] < targets[first + g]) : 0;                         \
+    }                                                                                                                           \
+}                                                                                                                               \
+                                                                                                                                \
+/* First index in [low, high) whose element is >= target (high if none), by plain bisection; counts its probes. */              \
+int name##_bisect(const T *arr, int low, int high, T target) {                                                                  \
+    while (low < high) {                                                                                                        \
+        int mid = low + (high - low) / 2;                                                                                       \
+        probe_count++;                                                                                                          \
+        if (arr[mid] < target) low = mid + 1; else high = mid;                                                                  \
+    }                                                                                                                           \
+    return low;                                                                                                                 \
+}                                                                                                                               \
+                                                                                                                                \
+/* Lower bound by interpolation: with arr[low] < target <= arr[high], probe where a straight line between the two keys */       \
+/* puts the target. Uniform keys need about log log n probes. A probe that fails to halve the range is followed by a */         \
+/* bisection step, so skewed keys cost at most about twice the probes of a binary search instead of O(n). */                    \
+int name##_interpolation_lower_bound(const T *arr, int size, T target) {                                                        \
+    if (size <= 0) return 0;                                                                                                    \
+    probe_count++;                                                                                                              \
+    if (!(arr[0] < target)) return 0;                                                                                           \
+    probe_count++;                                                                                                              \
+    if (arr[size - 1] < target) return size;                                                                                    \
+    int low = 0, high = size - 1, bisect = 0;                                                                                   \
+    T low_key = arr[0], high_key = arr[size - 1];                                                                               \
+    while (high - low > 1) {                                                                                                    \
+        int width = high - low, pos;                                                                                            \
+        if (bisect) pos = low + width / 2;                                                                                      \
+        else {                                                                                                                  \
+            double fraction = ((double)target - (double)low_key) / ((double)high_key - (double)low_key);                        \
+            if (!(fraction >= 0 && fraction <= 1)) fraction = 0.5; /* Infinite or NaN keys */                                   \
+            pos = low + (int)(fraction * width);                                                                                \
+            pos = pos <= low ? low + 1 : pos >= high ? high - 1 : pos;                                                          \
+        }                                                                                                                       \
+        probe_count++;                                                                                                          \
+        if (arr[pos] < target) low = pos, low_key = arr[pos];                                                                   \
+        else high = pos, high_key = arr[pos];                                                                                   \
+        bisect = !bisect && high - low > width / 2;                                                                             \
+    }                                                                                                                           \
+    return high;                                                                                                                \
+}                                                                                                                               \
+                                                                                                                                \
+/* Lower bound by exponential (galloping) search from a hint: step 1, 2, 4, ... elements away from arr[hint] towards */         \
+/* the target until it is passed, then bisect the last step. Costs about 2 log d probes for an answer d elements from */        \
+/* the hint, so targets near the front (hint 0) or near a previous answer are cheap whatever the array size. */                 \
+int name##_exponential_lower_bound(const T *arr, int size, T target, int hint) {                                                \
+    if (size <= 0) return 0;                                                                                                    \
+    hint = hint < 0 ? 0 : hint >= size ? size - 1 : hint;                                                                       \
+    probe_count++;                                                                                                              \
+    int low, high, step = 1; /* The answer is in (low, high] */                                                                 \
+    if (arr[hint] < target) {                                                                                                   \
+        low = hint;                                                                                                             \
+        while (step < size - hint && (probe_count++, arr[hint + step] < target)) {                                              \
+            low = hint + step;                                                                                                  \
+            step = step <= (size - hint) / 2 ? step * 2 : size - hint;                                                          \
+        }                                                                                                                       \
+        high = step < size - hint ? hint + step : size;                                                                         \
+    } else {                                                                                                                    \
+        high = hint;                                                                                                            \
+        while (step <= hint && (probe_count++, !(arr[hint - step] < target))) {                                                 \
+            high = hint - step;                                                                                                 \
+            step = step <= hint / 2 ? step * 2 : hint + 1;                                                                      \
+        }                                                                                                                       \
+        low = hint - step;                                                                                                      \
+    }                                                                                                                           \
+    return name##_bisect(arr, low + 1, high, target);                                                                           \
+}                                                                                                                               \
+                                                                                                                                \
+/* Lower bounds of ascending targets: each search gallops forward from the previous answer (1, 2, 4, ... elements) */           \
+/* and finishes with a lower bound inside the last gap, so close targets cost O(log gap) instead of O(log n). */                \
+void name##_lower_bound_sorted(const T *arr, int size, const T *targets, int count, int *results) {                             \
+    int low = 0; /* Everything before `low` is < the current target */                                                          \
+    for (int q = 0; q < count; q++) {                                                                                           \
+        T target = targets[q];                                                                                                  \
+        int high = low, step = 1;                                                                                               \
+        while (high < size && arr[high] < target) {                                                                             \
+            low = high + 1;                                                                                                     \
+            high = step < size - high ? high + step : size;                                                                     \
+            step *= 2;                                                                                                          \
+        }                                                                                                                       \
+        low += name##_lower_bound(arr + low, high - low, target);                                                               \
+        results[q] = low;                                                                                                       \
+    }                                                                                                                           \
+}
+
+DEFINE_SEARCH_KERNELS(search_int, int)
+DEFINE_SEARCH_KERNELS(search_float, float)
+
+/**
+ * Searches a sorted int or float array with the branchless lower bound.
+ *
+ * Unlike `binary_search()` it never stops early on a match: it always runs log2(n) steps with no
+ * unpredictable branch, then checks the one element it lands on. With duplicates it finds the first.
+ *
+ * @param arr       Pointer to the sorted array.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements: 'i' for int, 'f' for float.
+ * @param target    Pointer to the target value to search for.
+ * @return          Index of found element, -1 if not found, -2 for other types.
+ */
+int binary_search_branchless(void *arr, int size, char type, void *target) {
+    int i;
+    switch (type) {
+        case 'i':
+            i = search_int_lower_bound(arr, size, *(int*)target);
+            return i < size && ((int*)arr)[i] == *(int*)target ? i : -1;
+        case 'f':
+            i = search_float_lower_bound(arr, size, *(float*)target);
+            return i < size && ((float*)arr)[i] == *(float*)target ? i : -1;
+        default:
+            return -2; // Only ints and floats
+    }
+}
+
+/**
+ * Searches a sorted int or float array by interpolation (see `_interpolation_lower_bound`): few
+ * probes on evenly spread keys such as timestamps or IDs, at most about twice a binary search's
+ * probes on skewed ones. Probes are added to `probe_count`.
+ *
+ * @param arr       Pointer to the sorted array.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements: 'i' for int, 'f' for float.
+ * @param target    Pointer to the target value to search for.
+ * @return          Index of found element (the first if duplicated), -1 if not found, -2 for other types.
+ */
+int interpolation_search(void *arr, int size, char type, void *target) {
+    int i;
+    switch (type) {
+        case 'i':
+            i = search_int_interpolation_lower_bound(arr, size, *(int*)target);
+            return i < size && ((int*)arr)[i] == *(int*)target ? i : -1;
+        case 'f':
+            i = search_float_interpolation_lower_bound(arr, size, *(float*)target);
+            return i < size && ((float*)arr)[i] == *(float*)target ? i : -1;
+        default:
+            return -2; // Only ints and floats
+    }
+}
+
+/**
+ * Searches a sorted int or float array by galloping from a hint (see `_exponential_lower_bound`):
+ * the cost grows with the distance between the hint and the answer, not with the array size.
+ * Probes are added to `probe_count`.
+ *
+ * @param arr       Pointer to the sorted array.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements: 'i' for int, 'f' for float.
+ * @param target    Pointer to the target value to search for.
+ * @param hint      Index to start from (0 for targets near the front).
+ * @return          Index of found element (the first if duplicated), -1 if not found, -2 for other types.
+ */
+int exponential_search(void *arr, int size, char type, void *target, int hint) {
+    int i;
+    switch (type) {
+        case 'i':
+            i = search_int_exponential_lower_bound(arr, size, *(int*)target, hint);
+            return i < size && ((int*)arr)[i] == *(int*)target ? i : -1;
+        case 'f':
+            i = search_float_exponential_lower_bound(arr, size, *(float*)target, hint);
+            return i < size && ((float*)arr)[i] == *(float*)target ? i : -1;
+        default:
+            return -2; // Only ints and floats
+    }
+}
+
+/**
+ * Picks the search for `--mode auto` from a cheap sample of the keys: `AUTO_SAMPLES` evenly spaced
+ * keys are placed on the straight line from the first to the last key. If none lands more than
+ * `AUTO_MAX_ERROR` of the array away from its real index, interpolation guesses well and wins;
+ * otherwise binary search is the safe choice.
+ *
+ * @param arr       Pointer to the sorted array.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements.
+ * @return          `MODE_INTERP` or `MODE_BINARY`.
+ */
+search_mode_t auto_search_mode(void *arr, int size, char type) {
+    if ((type != 'i' && type != 'f') || size < 2) return MODE_BINARY;
+    double first = type == 'i' ? ((int*)arr)[0] : ((float*)arr)[0];
+    double range = (type == 'i' ? ((int*)arr)[size - 1] : ((float*)arr)[size - 1]) - first;
+    if (!(range > 0) || range > 1e300) return MODE_BINARY; // All keys equal, or infinite / NaN keys
+
+    for (int sample = 1; sample < AUTO_SAMPLES; sample++) {
+        int i = (int)((long long)sample * (size - 1) / AUTO_SAMPLES);
+        double key = type == 'i' ? ((int*)arr)[i] : ((float*)arr)[i];
+        double guess = (key - first) / range * (size - 1);
+        if (guess - i > AUTO_MAX_ERROR * size || i - guess > AUTO_MAX_ERROR * size) return MODE_BINARY;
+    }
+    return MODE_INTERP;
+}
+
+/**
+ * Resolves `--mode` to the search that actually runs on an array: `MODE_AUTO` samples the keys, and
+ * characters and strings always take `binary_search()`, whatever the mode, so the timing lines and
+ * probe counts name what ran.
+ *
+ * @param arr       Pointer to the sorted array.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements.
+ * @param requested Mode of `--mode`.
+ * @return          The mode `search_with_mode()` runs (never `MODE_AUTO`).
+ */
+search_mode_t resolve_search_mode(void *arr, int size, char type, search_mode_t requested) {
+    if (type != 'i' && type != 'f') return MODE_BINARY;
+    return requested == MODE_AUTO ? auto_search_mode(arr, size, type) : requested;
+}
+
+/**
+ * Tells whether searches of a (resolved, not auto) mode add their probes to `probe_count`.
+ *
+ * @param type      Data type of the array elements.
+ * @param mode      Mode the search runs with.
+ * @return          1 for `binary_search()` (every type), interpolation and exponential search, 0 otherwise.
+ */
+int mode_counts_probes(char type, search_mode_t mode) {
+    return (type != 'i' && type != 'f') || mode == MODE_BINARY || mode == MODE_INTERP || mode == MODE_EXP;
+}
+
+/**
+ * Names a mode for the timing lines, showing what `--mode auto` picked, e.g. "auto: interp".
+ *
+ * @param label     Receives the name (at least 32 bytes).
+ * @param requested Mode of `--mode`.
+ * @param mode      Mode that actually ran.
+ * @return          void
+ */
+void mode_label(char *label, search_mode_t requested, search_mode_t mode) {
+    if (requested == MODE_AUTO) snprintf(label, 32, "auto: %s", mode_names[mode]);
+    else snprintf(label, 32, "%s", mode_names[mode]);
+}
+
+/**
+ * Searches a file's worth of targets with `--mode`. Without `--mode`, and with `--mode branchless` on
+ * ints and floats, the whole batch goes to `search_batch()`; `--mode eytzinger` searches the index the
+ * caller built (or mapped) once. The other modes run one search per target and count their probes (exp
+ * gallops from the previous hit, so ascending targets stay cheap); characters and strings always run
+ * `binary_search()`, and the label says so.
+ *
+ * @param arr       Pointer to the sorted array.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements.
+ * @param index     Eytzinger index of the array for `--mode eytzinger`, NULL if there is none (chars and
+ *                      strings), in which case `binary_search()` answers.
+ * @param targets   Array of `count` targets (`STRING_LENGTH`-byte rows for strings).
+ * @param count     Number of targets.
+ * @param results   Receives the index of every target, -1 if not found.
+ * @param label     Receives what ran, e.g. "auto: interp" or "batch: interleaved" (at least 32 bytes).
+ * @return          1 if `probe_count` counted the probes, 0 otherwise.
+ */
+int search_queries(void *arr, int size, char type, const eytzinger_t *index, const void *targets, int count, int *results, char *label) {
+    size_t width = type == 's' ? STRING_LENGTH : type == 'c' ? sizeof(char) : sizeof(int);
+    if (!mode_chosen || (search_mode == MODE_BRANCHLESS && (type == 'i' || type == 'f'))) {
+        batch_path_t path = search_batch(arr, size, type, targets, count, results);
+        snprintf(label, 32, "%s: %s", mode_chosen ? mode_names[search_mode] : "batch", batch_path_names[path]);
+        return 0;
+    }
+    if (index) {
+        snprintf(label, 32, "%s", mode_names[MODE_EYTZINGER]);
+        for (int q = 0; q < count; q++) results[q] = eytzinger_search(index, (char*)targets + q * width);
+        return 0;
+    }
+
+    search_mode_t mode = resolve_search_mode(arr, size, type, search_mode);
+    if (mode == MODE_EYTZINGER) mode = MODE_BINARY; // No index: never build a throwaway one per target
+    mode_label(label, search_mode, mode);
+    int hint = 0;
+    for (int q = 0; q < count; q++) {
+        void *target = (char*)targets + q * width;
+        if (mode == MODE_EXP && (type == 'i' || type == 'f')) {
+            results[q] = exponential_search(arr, size, type, target, hint);
+            if (results[q] >= 0) hint = results[q];
+        } else results[q] = search_with_mode(arr, size, type, target, mode, 0);
+    }
+    return mode_counts_probes(type, mode);
+}
+
+/**
+ * Searches a sorted array for a whole batch of targets.
+ *
+ * Ints and floats take one of two paths:
+ * - ascending targets (checked in O(count)) reuse the previous answer as a lower bound and gallop
+ *   forward from it, so a dense run of queries touches each cache line about once;
+ * - otherwise groups of `BATCH_GROUP` branchless searches advance in lockstep, so up to
+ *   `BATCH_GROUP` cache misses are outstanding at a time instead of one.
+ * Characters and strings are searched one by one with `binary_search()`.
+ *
+ * @param arr       Pointer to the sorted array.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char[STRING_LENGTH]).
+ * @param targets   Array of `count` targets of the same type (`STRING_LENGTH`-byte rows for strings).
+ * @param count     Number of targets.
+ * @param results   Receives, per target, its index (the first if duplicated for ints and floats) or -1.
+ * @return          The path taken: `BATCH_INTERLEAVED`, `BATCH_SORTED` or `BATCH_ONE_BY_ONE`.
+ */
+batch_path_t search_batch(void *arr, int size, char type, const void *targets, int count, int *results) {
+    if (type != 'i' && type != 'f') {
+        size_t width = type == 's' ? STRING_LENGTH : sizeof(char);
+        for (int q = 0; q < count; q++) results[q] = binary_search(arr, size, type, (char*)targets + q * width, 0);
+        return BATCH_ONE_BY_ONE;
+    }
+
+    int ascending = 1;
+    if (type == 'i') for (int q = 1; q < count && ascending; q++) ascending = ((const int*)targets)[q - 1] <= ((const int*)targets)[q];
+    else for (int q = 1; q < count && ascending; q++) ascending = ((const float*)targets)[q - 1] <= ((const float*)targets)[q];
+
+    if (type == 'i') {
+        if (ascending) search_int_lower_bound_sorted(arr, size, targets, count, results);
+        else search_int_lower_bound_batch(arr, size, targets, count, results);
+        for (int q = 0; q < count; q++)
+            if (results[q] >= size || ((int*)arr)[results[q]] != ((const int*)targets)[q]) results[q] = -1;
+    } else {
+        if (ascending) search_float_lower_bound_sorted(arr, size, targets, count, results);
+        else search_float_lower_bound_batch(arr, size, targets, count, results);
+        for (int q = 0; q < count; q++)
+            if (results[q] >= size || ((float*)arr)[results[q]] != ((const float*)targets)[q]) results[q] = -1;
+    }
+    return ascending ? BATCH_SORTED : BATCH_INTERLEAVED;
+}
+
+/**
+ * Builds the static Eytzinger index of a sorted int or float array.
+ *
+ * The keys are stored in BFS order of the implicit search tree, so the first levels a search visits
+ * sit next to each other in a few cache lines, and the 16 grandchildren 4 levels below a node share
+ * one line, which the search prefetches. The sorted array itself is not needed for searching.
+ *
+ * @param index     Index to fill; release it with `eytzinger_free()`.
+ * @param arr       Pointer to the sorted array.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements: 'i' for int, 'f' for float.
+ * @return          0 on success, -1 for other types.
+ */
+int eytzinger_build(eytzinger_t *index, void *arr, int size, char type) {
+    if (type != 'i' && type != 'f') return -1;
+    size_t bytes = ((size_t)size + 1) * sizeof(int32_t);
+    index->type = type;
+    index->size = size;
+    index->keys = aligned_alloc(CACHE_LINE, (bytes + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE);
+    index->rank = malloc(((size_t)size + 1) * sizeof(int));
+    index->keys[0] = 0; // Slot 0 is never searched; zeroed so a saved index is reproducible
+    index->rank[0] = -1;
+    eytzinger_fill(arr, index, 0, 1);
+    return 0;
+}
+
+/**
+ * Fills the subtree rooted at slot k with the next sorted keys by an in-order walk.
+ *
+ * @param sorted    Sorted keys (ints and floats as their 32 bits).
+ * @param index     Index being built.
+ * @param next      Index of the next sorted key to place.
+ * @param k         Root slot of the subtree.
+ * @return          Index of the next sorted key after the subtree.
+ */
+int eytzinger_fill(const int32_t *sorted, eytzinger_t *index, int next, size_t k) {
+    if (k > (size_t)index->size) return next;
+    next = eytzinger_fill(sorted, index, next, 2 * k);
+    index->keys[k] = sorted[next];
+    index->rank[k] = next++;
+    return eytzinger_fill(sorted, index, next, 2 * k + 1);
+}
+
+/**
+ * Searches an Eytzinger index.
+ *
+ * @param index     Index built by `eytzinger_build()`.
+ * @param target    Pointer to the target value (int or float, as the index).
+ * @return          Index of the target in the sorted array (the first if duplicated), -1 if not found.
+ */
+int eytzinger_search(const eytzinger_t *index, void *target) {
+    size_t k;
+    if (index->type == 'i') {
+        k = search_int_eytzinger_lower_bound((const int*)index->keys, index->size, *(int*)target);
+        return k && ((const int*)index->keys)[k] == *(int*)target ? index->rank[k] : -1;
+    }
+    k = search_float_eytzinger_lower_bound((const float*)index->keys, index->size, *(float*)target);
+    return k && ((const float*)index->keys)[k] == *(float*)target ? index->rank[k] : -1;
+}
+
+/**
+ * Releases an Eytzinger index.
+ *
+ * @param index     Index built by `eytzinger_build()`.
+ * @return          void
+ */
+void eytzinger_free(eytzinger_t *index) {
+    free(index->keys);
+    free(index->rank);
+}
+
+/**
+ * Searches a sorted array with the given mode. Characters and strings (and ints and floats in
+ * binary mode) use `binary_search()`; the Eytzinger mode builds a throwaway index first.
+ *
+ * @param arr       Pointer to the sorted array.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char[STRING_LENGTH]).
+ * @param target    Pointer to the target value to search for.
+ * @param mode      Any `search_mode_t`; `MODE_AUTO` samples the keys with `auto_search_mode()` first.
+ * @param visualize Flag to enable step-by-step visualization of the binary mode. (1 = enable, 0 = disable)
+ * @return          Index of found element, -1 if not found, -2 for unknown type.
+ */
+int search_with_mode(void *arr, int size, char type, void *target, search_mode_t mode, int visualize) {
+    if (mode == MODE_AUTO) mode = auto_search_mode(arr, size, type);
+    if ((type != 'i' && type != 'f') || mode == MODE_BINARY) return binary_search(arr, size, type, target, visualize);
+    if (mode == MODE_BRANCHLESS) return binary_search_branchless(arr, size, type, target);
+    if (mode == MODE_INTERP) return interpolation_search(arr, size, type, target);
+    if (mode == MODE_EXP) return exponential_search(arr, size, type, target, 0);
+
+    eytzinger_t index;
+    eytzinger_build(&index, arr, size, type);
+    int result = eytzinger_search(&index, target);
+    eytzinger_free(&index);
+    return result;
+}
+
+/**
+ * Benchmarks the search modes on sorted ints: lookups per second of `binary_search()`, the branchless
+ * lower bound and the Eytzinger index.
+ *
+ * Array sizes go from 2^10 up to `max_size` (times 16 per row), the keys are the even numbers, and
+ * every cell looks up the same `BENCHMARK_LOOKUPS` random targets (about half of them missing). The
+ * results of the other two are compared with `binary_search()`.
+ *
+ * @param max_size  Largest array size.
+ * @return          void
+ */
+void run_benchmark(int max_size) {
+    int *targets = malloc(BENCHMARK_LOOKUPS * sizeof(int));
+    int *expected = malloc(BENCHMARK_LOOKUPS * sizeof(int));
+
+    printf(MAGENTA "Binary Search Benchmark\n");
+    printf("=======================\n" RESET);
+    printf("%d random lookups per cell, millions of lookups per second\n", BENCHMARK_LOOKUPS);
+    printf(BOLD "\n%-12s %11s %11s %11s %9s %13s   %s\n" RESET, "Size", "Binary", "Branchless", "Eytzinger", "Speedup", "Index build", "vs binary");
+
+    srand(42); // Fixed seed so runs are comparable
+    for (long long size = 1 << 10; size <= max_size; size *= 16) {
+        int n = (int)size;
+        int *arr = malloc(size * sizeof(int));
+        for (int i = 0; i < n; i++) arr[i] = 2 * i;
+        for (int q = 0; q < BENCHMARK_LOOKUPS; q++) targets[q] = (int)(((long long)rand() * RAND_MAX + rand()) % (2 * size));
+
+        double start = now_seconds();
+        eytzinger_t index;
+        eytzinger_build(&index, arr, n, 'i');
+        double build_time = now_seconds() - start;
+
+        double rates[MODE_EYTZINGER + 1];
+        int ok = 1;
+        for (int mode = 0; mode <= MODE_EYTZINGER; mode++) {
+            start = now_seconds();
+            for (int q = 0; q < BENCHMARK_LOOKUPS; q++) {
+                int result;
+                if (mode == MODE_BINARY) result = binary_search(arr, n, 'i', &targets[q], 0);
+                else if (mode == MODE_BRANCHLESS) result = binary_search_branchless(arr, n, 'i', &targets[q]);
+                else result = eytzinger_search(&index, &targets[q]);
+
+                if (mode == MODE_BINARY) expected[q] = result;
+                else if (result != expected[q]) ok = 0;
+            }
+            rates[mode] = BENCHMARK_LOOKUPS / (now_seconds() - start) / 1e6;
+        }
+
+        double best = rates[MODE_BRANCHLESS] > rates[MODE_EYTZINGER] ? rates[MODE_BRANCHLESS] : rates[MODE_EYTZINGER];
+        printf("%-12d %11.2f %11.2f %11.2f %8.2fx %11.3f s   ", n, rates[MODE_BINARY], rates[MODE_BRANCHLESS], rates[MODE_EYTZINGER], best / rates[MODE_BINARY], build_time);
+        printf(ok ? GREEN "✓ match" RESET "\n" : RED "✗ MISMATCH" RESET "\n");
+
+        eytzinger_free(&index);
+        free(arr);
+    }
+    free(targets);
+    free(expected);
+}
+
+/**
+ * Benchmarks batched lookups on `size` sorted ints (the even numbers): `BENCHMARK_LOOKUPS` random
+ * targets one by one (`binary_search()` and the branchless lower bound) and as one interleaved batch,
+ * then the same targets in ascending order one by one and through the sorted-queries path. Every
+ * result is compared with the one-by-one branchless search.
+ *
+ * @param size      Array size.
+ * @return          void
+ */
+void run_batch_benchmark(int size) {
+    const char *names[] = {"Random, binary_search() one by one", "Random, branchless one by one", "Random, interleaved batch",
+                           "Ascending, branchless one by one", "Ascending, sorted-queries batch"};
+    int *arr = malloc(size * sizeof(int));
+    int *targets = malloc(BENCHMARK_LOOKUPS * sizeof(int));
+    int *expected = malloc(BENCHMARK_LOOKUPS * sizeof(int));
+    int *results = malloc(BENCHMARK_LOOKUPS * sizeof(int));
+    for (int i = 0; i < size; i++) arr[i] = 2 * i;
+    srand(42); // Fixed seed so runs are comparable
+    for (int q = 0; q < BENCHMARK_LOOKUPS; q++) targets[q] = (int)(((long long)rand() * RAND_MAX + rand()) % (2LL * size));
+
+    printf(MAGENTA "Batched Binary Search Benchmark\n");
+    printf("===============================\n" RESET);
+    printf("%d lookups in %d sorted ints, %d searches in lockstep\n", BENCHMARK_LOOKUPS, size, BATCH_GROUP);
+    printf(BOLD "\n%-36s %14s %9s   %s\n" RESET, "Method", "M lookups/s", "Speedup", "Results");
+
+    double baseline = 0;
+    for (int method = 0; method < 5; method++) {
+        if (method == 0 || method == 3) { // Reference answers for this target order (the keys are distinct, so every method agrees)
+            if (method == 3) qsort(targets, BENCHMARK_LOOKUPS, sizeof(int), compare_int);
+            for (int q = 0; q < BENCHMARK_LOOKUPS; q++) expected[q] = binary_search_branchless(arr, size, 'i', &targets[q]);
+        }
+
+        double start = now_seconds();
+        if (method == 0) for (int q = 0; q < BENCHMARK_LOOKUPS; q++) results[q] = binary_search(arr, size, 'i', &targets[q], 0);
+        else if (method == 1 || method == 3) for (int q = 0; q < BENCHMARK_LOOKUPS; q++) results[q] = binary_search_branchless(arr, size, 'i', &targets[q]);
+        else search_batch(arr, size, 'i', targets, BENCHMARK_LOOKUPS, results);
+        double rate = BENCHMARK_LOOKUPS / (now_seconds() - start) / 1e6;
+        if (method == 0) baseline = rate;
+
+        printf("%-36s %14.2f %8.2fx   ", names[method], rate, rate / baseline);
+        printf(memcmp(results, expected, BENCHMARK_LOOKUPS * sizeof(int)) == 0 ? GREEN "✓ match" RESET "\n" : RED "✗ MISMATCH" RESET "\n");
+    }
+    free(arr);
+    free(targets);
+    free(expected);
+    free(results);
+}
+
+/**
+ * Returns a monotonic timestamp in seconds, used for benchmark timing.
+ *
+ * @return          Current monotonic time in seconds.
+ */
+double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Benchmarks binary, interpolation, exponential and auto search on `size` sorted ints: probes per
+ * lookup (array elements read, from `probe_count`) and millions of lookups per second.
+ *
+ * Two key sets: "uniform" (4i plus a random 0-3, like timestamps or IDs) and "skewed" (i^2, scaled
+ * to fit an int). Two target sets of `BENCHMARK_LOOKUPS` each: random values over the key range, and
+ * keys (or one past them) among the first `MODE_BENCHMARK_FRONT`. Every result is checked against the
+ * branchless lower bound.
+ *
+ * @param size      Array size.
+ * @return          void
+ */
+void run_mode_benchmark(int size) {
+    const char *key_names[] = {"uniform", "skewed"};
+    const char *target_names[] = {"random", "front"};
+    const search_mode_t modes[] = {MODE_BINARY, MODE_INTERP, MODE_EXP, MODE_AUTO};
+    int *arr = malloc(size * sizeof(int));
+    int *targets = malloc(BENCHMARK_LOOKUPS * sizeof(int));
+    int *expected = malloc(BENCHMARK_LOOKUPS * sizeof(int));
+    int *results = malloc(BENCHMARK_LOOKUPS * sizeof(int));
+
+    printf(MAGENTA "Search Mode Benchmark\n");
+    printf("=====================\n" RESET);
+    printf("%d lookups per row in %d sorted ints\n", BENCHMARK_LOOKUPS, size);
+    printf(BOLD "\n%-9s %-10s %-16s %14s %12s %9s   %s\n" RESET, "Keys", "Targets", "Mode", "Probes/lookup", "M lookups/s", "Speedup", "Results");
+
+    int shift = 0; // i^2 >> shift stays below 2^30
+    while (((long long)size * size >> shift) >= 1LL << 30) shift++;
+    srand(42); // Fixed seed so runs are comparable
+    for (int keys = 0; keys < 2; keys++) {
+        for (int i = 0; i < size; i++) arr[i] = keys == 0 ? 4 * i + rand() % 4 : (int)((long long)i * i >> shift);
+        long long range = (long long)arr[size - 1] - arr[0] + 1;
+        int front = size < MODE_BENCHMARK_FRONT ? size : MODE_BENCHMARK_FRONT;
+
+        for (int set = 0; set < 2; set++) {
+            for (int q = 0; q < BENCHMARK_LOOKUPS; q++) {
+                if (set == 0) targets[q] = (int)(arr[0] + ((long long)rand() * RAND_MAX + rand()) % range);
+                else targets[q] = arr[rand() % front] + rand() % 2;
+                expected[q] = binary_search_branchless(arr, size, 'i', &targets[q]);
+            }
+
+            double baseline = 0;
+            for (int m = 0; m < 4; m++) {
+                probe_count = 0;
+                double start = now_seconds();
+                search_mode_t mode = modes[m] == MODE_AUTO ? auto_search_mode(arr, size, 'i') : modes[m]; // Decided once per array
+                for (int q = 0; q < BENCHMARK_LOOKUPS; q++) results[q] = search_with_mode(arr, size, 'i', &targets[q], mode, 0);
+                double rate = BENCHMARK_LOOKUPS / (now_seconds() - start) / 1e6;
+                if (m == 0) baseline = rate;
+
+                // binary_search() may return any of equal keys, so results are compared by the key they point at
+                int ok = 1;
+                for (int q = 0; q < BENCHMARK_LOOKUPS && ok; q++)
+                    ok = (results[q] == -1) == (expected[q] == -1) && (results[q] == -1 || arr[results[q]] == targets[q]);
+
+                char name[32];
+                if (modes[m] == MODE_AUTO) snprintf(name, sizeof(name), "auto (%s)", mode_names[mode]);
+                else snprintf(name, sizeof(name), "%s", mode_names[mode]);
+                printf("%-9s %-10s %-16s %14.2f %12.2f %8.2fx   ", key_names[keys], target_names[set], name,
+                       (double)probe_count / BENCHMARK_LOOKUPS, rate, rate / baseline);
+                printf(ok ? GREEN "✓ match" RESET "\n" : RED "✗ MISMATCH" RESET "\n");
+            }
+        }
+    }
+    free(arr);
+    free(targets);
+    free(expected);
+    free(results);
+}
+
+/**
+ * Compares two ints for `qsort()` (`sort_array()` and the batch benchmark).
+ *
+ * @param a         Pointer to the first int.
+ * @param b         Pointer to the second int.
+ * @return          Negative, zero or positive as *a is less than, equal to or greater than *b.
+ */
+int compare_int(const void *a, const void *b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Compares two floats for `qsort()`.
+ *
+ * @param a         Pointer to the first float.
+ * @param b         Pointer to the second float.
+ * @return          Negative, zero or positive as *a is less than, equal to or greater than *b.
+ */
+int compare_float(const void *a, const void *b) {
+    float x = *(const float*)a, y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Compares two characters for `qsort()`.
+ *
+ * @param a         Pointer to the first character.
+ * @param b         Pointer to the second character.
+ * @return          Negative, zero or positive as *a is less than, equal to or greater than *b.
+ */
+int compare_char(const void *a, const void *b) {
+    return *(const char*)a - *(const char*)b;
+}
+
+/**
+ * Compares two `STRING_LENGTH`-byte string rows for `qsort()`.
+ *
+ * @param a         Pointer to the first row.
+ * @param b         Pointer to the second row.
+ * @return          `strcmp()` of the two strings.
+ */
+int compare_string(const void *a, const void *b) {
+    return strcmp(a, b);
+}
+
+/**
+ * Parses a `--target` value as the element type of an array.
+ *
+ * @param type      'i', 'f', 'c' or 's'.
+ * @param text      Target value as text.
+ * @param target    Receives the value (`STRING_LENGTH` bytes, zero-filled by the caller).
+ * @return          0 on success, 1 if a string target is too long (message printed to stderr).
+ */
+int parse_target(char type, const char *text, char *target) {
+    switch (type) {
+        case 'i': *(int*)target = (int)strtol(text, NULL, 10); break;
+        case 'f': *(float*)target = strtof(text, NULL); break;
+        case 'c': target[0] = text[0]; break;
+        case 's':
+            if (strlen(text) >= STRING_LENGTH) {
+                fprintf(stderr, "Target is longer than %d characters!\n", STRING_LENGTH - 1);
+                return 1;
+            }
+            strcpy(target, text);
+            break;
+    }
+    return 0;
+}
+
+/**
+ * Copies lines into `STRING_LENGTH`-byte rows, the string layout of `binary_search()`.
+ *
+ * @param lines     Lines loaded by `array_file_load()`.
+ * @param count     Number of lines.
+ * @param what      File the lines come from, for the error message.
+ * @return          Newly allocated rows (free with `free()`), NULL if a line is too long.
+ */
+char *lines_to_rows(char **lines, int count, const char *what) {
+    char (*rows)[STRING_LENGTH] = calloc(count ? count : 1, STRING_LENGTH);
+    for (int i = 0; i < count; i++) {
+        if (strlen(lines[i]) >= STRING_LENGTH) {
+            fprintf(stderr, "%s line %d is longer than %d characters!\n", what, i + 1, STRING_LENGTH - 1);
+            free(rows);
+            return NULL;
+        }
+        strcpy(rows[i], lines[i]);
+    }
+    return (char*)rows;
+}
+
+/**
+ * Loads an array file, sorts it and searches it for one target or a file of targets, without any prompts.
+ *
+ * With `--target`, prints the index of the target (or -1) to stdout. With `--queries`, the targets
+ * file (same format as the array) is searched as one batch with `search_batch()` and one index per
+ * target is printed, in the order of the file. Phase timings go to stderr either way.
+ *
+ * @param input_path   Array file to search.
+ * @param format       "i32", "f32", "u8" or "lines".
+ * @param target_text  Target value as text (parsed as the file's element type), or NULL.
+ * @param queries_path Targets file, or NULL.
+ * @return             0 on success, 1 on error.
+ */
+int search_array_file(const char *input_path, const char *format, const char *target_text, const char *queries_path) {
+    char type = array_file_type(format);
+    if (!type || (!target_text && !queries_path)) {
+        fprintf(stderr, "--in needs --format i32, f32, u8 or lines and --target VALUE or --queries FILE!\n");
+        return 1;
+    }
+
+    array_file_t file, queries_file;
+    int size, count = 0;
+    double start = array_file_seconds();
+    void *loaded = array_file_load(&file, input_path, type, &size);
+    if (!loaded) return 1;
+
+    void *arr = loaded, *queries = NULL, *queries_loaded = NULL;
+    char target[STRING_LENGTH] = {0};
+    if (queries_path) {
+        queries = queries_loaded = array_file_load(&queries_file, queries_path, type, &count);
+        if (!queries_loaded) {
+            array_file_close(&file);
+            return 1;
+        }
+    } else if (parse_target(type, target_text, target) != 0) {
+        array_file_close(&file);
+        return 1;
+    }
+    if (type == 's') {
+        arr = lines_to_rows(loaded, size, input_path);
+        if (arr && queries) queries = lines_to_rows(queries_loaded, count, queries_path);
+        if (!arr || (queries_loaded && !queries)) {
+            if (queries != queries_loaded) free(queries);
+            free(arr);
+            if (queries_loaded) array_file_close(&queries_file);
+            array_file_close(&file);
+            return 1;
+        }
+    }
+    double load_time = array_file_seconds() - start;
+
+    start = array_file_seconds();
+    int sorted = array_is_sorted(arr, size, type);
+    double check_time = array_file_seconds() - start;
+    start = array_file_seconds();
+    if (!sorted) sort_array(arr, size, type);
+    double sort_time = array_file_seconds() - start;
+
+    if (queries) {
+        // Like a single target, the Eytzinger index is built once and timed on its own
+        start = array_file_seconds();
+        eytzinger_t index;
+        int indexed = search_mode == MODE_EYTZINGER && eytzinger_build(&index, arr, size, type) == 0;
+        double index_time = array_file_seconds() - start;
+
+        int *results = malloc((count ? count : 1) * sizeof(int));
+        char label[32];
+        probe_count = 0;
+        start = array_file_seconds();
+        int counted = search_queries(arr, size, type, indexed ? &index : NULL, queries, count, results, label);
+        double search_time = array_file_seconds() - start;
+        if (indexed) eytzinger_free(&index);
+
+        for (int q = 0; q < count; q++) printf("%d\n", results[q]);
+        fprintf(stderr, "%d elements, %d queries (%s, %s): load %.3f s, check %.6f s, sort %.3f s%s, ", size, count, format, label,
+                load_time, check_time, sort_time, sorted ? " (skipped)" : "");
+        if (indexed) fprintf(stderr, "index %.3f s, ", index_time);
+        fprintf(stderr, "search %.6f s (%.2f M lookups/s", search_time, search_time > 0 ? count / search_time / 1e6 : 0.0);
+        if (counted) fprintf(stderr, ", %.2f probes/lookup", count ? (double)probe_count / count : 0.0);
+        fprintf(stderr, ")\n");
+        free(results);
+        if (queries != queries_loaded) free(queries);
+        array_file_close(&queries_file);
+    } else {
+        // The Eytzinger index is built once here, so its cost shows up separately from the lookup
+        start = array_file_seconds();
+        eytzinger_t index;
+        int indexed = search_mode == MODE_EYTZINGER && eytzinger_build(&index, arr, size, type) == 0;
+        double index_time = array_file_seconds() - start;
+
+        probe_count = 0;
+        start = array_file_seconds();
+        search_mode_t mode = resolve_search_mode(arr, size, type, search_mode);
+        int result = indexed ? eytzinger_search(&index, target) : search_with_mode(arr, size, type, target, mode, 0);
+        double search_time = array_file_seconds() - start;
+        if (indexed) eytzinger_free(&index);
+
+        char label[32];
+        mode_label(label, search_mode, mode);
+        printf("%d\n", result);
+        fprintf(stderr, "%d elements (%s, %s): load %.3f s, check %.6f s, sort %.3f s%s, ", size, format, label,
+                load_time, check_time, sort_time, sorted ? " (skipped)" : "");
+        if (indexed) fprintf(stderr, "index %.3f s, ", index_time);
+        fprintf(stderr, "search %.6f s", search_time);
+        if (mode_counts_probes(type, mode)) fprintf(stderr, ", %lld probes", probe_count);
+        fprintf(stderr, "\n");
+    }
+
+    if (arr != loaded) free(arr);
+    array_file_close(&file);
+    return 0;
+}
+
+/**
+ * Builds an index file (`--build-index`): loads an array file, sorts it once in O(n log n) with
+ * `sort_array()` (unless it is already sorted) and saves the sorted elements behind a versioned
+ * header. With `--mode eytzinger` the Eytzinger layout of ints and floats is saved too, so searches
+ * never build it again.
+ *
+ * @param input_path  Array file to index.
+ * @param format      "i32", "f32", "u8" or "lines".
+ * @param index_path  Index file to write.
+ * @return            0 on success, 1 on error.
+ */
+int build_index_file(const char *input_path, const char *format, const char *index_path) {
+    char type = array_file_type(format);
+    if (!type) {
+        fprintf(stderr, "--build-index needs --format i32, f32, u8 or lines!\n");
+        return 1;
+    }
+
+    array_file_t file;
+    int size;
+    double start = array_file_seconds();
+    void *loaded = array_file_load(&file, input_path, type, &size);
+    if (!loaded) return 1;
+    void *arr = type == 's' ? lines_to_rows(loaded, size, input_path) : loaded;
+    if (!arr) {
+        array_file_close(&file);
+        return 1;
+    }
+    double load_time = array_file_seconds() - start;
+
+    size_t width = type == 's' ? STRING_LENGTH : type == 'c' ? sizeof(char) : sizeof(int);
+    start = array_file_seconds();
+    int sorted = array_is_sorted(arr, size, type);
+    double check_time = array_file_seconds() - start;
+    start = array_file_seconds();
+    if (!sorted) sort_array(arr, size, type);
+    double sort_time = array_file_seconds() - start;
+
+    start = array_file_seconds();
+    eytzinger_t index;
+    int indexed = search_mode == MODE_EYTZINGER && eytzinger_build(&index, arr, size, type) == 0;
+    double index_time = array_file_seconds() - start;
+
+    start = array_file_seconds();
+    int status = index_file_write(index_path, type, width, arr, size, indexed ? index.keys : NULL, indexed ? index.rank : NULL);
+    double write_time = array_file_seconds() - start;
+    if (indexed) eytzinger_free(&index);
+
+    if (status == 0) {
+        fprintf(stderr, "%d elements (%s): load %.3f s, check %.6f s, sort %.3f s%s, ", size, format, load_time, check_time, sort_time,
+                sorted ? " (skipped)" : "");
+        if (indexed) fprintf(stderr, "eytzinger %.3f s, ", index_time);
+        fprintf(stderr, "write %.3f s\n", write_time);
+    }
+    if (arr != loaded) free(arr);
+    array_file_close(&file);
+    return status;
+}
+
+/**
+ * Searches an index file (`--index`) for one target or a file of targets. The index is mapped as it
+ * is, so there is no parse and no sort before the first answer: a lookup only faults in the pages it
+ * probes. `--mode eytzinger` searches the saved Eytzinger block, the other modes the sorted payload.
+ *
+ * @param index_path   Index file written by `build_index_file()`.
+ * @param target_text  Target value as text (parsed as the index's element type), or NULL.
+ * @param queries_path Targets file in the format of the indexed file, or NULL.
+ * @return             0 on success, 1 on error.
+ */
+int search_index_file(const char *index_path, const char *target_text, const char *queries_path) {
+    if (!target_text && !queries_path) {
+        fprintf(stderr, "--index needs --target VALUE or --queries FILE!\n");
+        return 1;
+    }
+
+    index_file_t file;
+    double start = array_file_seconds();
+    if (index_file_open(&file, index_path, STRING_LENGTH) != 0) return 1;
+    double open_time = array_file_seconds() - start;
+
+    char type = file.type;
+    eytzinger_t index = {type, file.size, file.eytzinger_keys, file.eytzinger_rank};
+    if (search_mode == MODE_EYTZINGER && !file.eytzinger_keys && (type == 'i' || type == 'f')) {
+        fprintf(stderr, "'%s' has no Eytzinger block, rebuild it with --mode eytzinger!\n", index_path);
+        index_file_close(&file);
+        return 1;
+    }
+    int use_eytzinger = search_mode == MODE_EYTZINGER && file.eytzinger_keys;
+
+    if (queries_path) {
+        array_file_t queries_file;
+        int count;
+        start = array_file_seconds();
+        void *queries_loaded = array_file_load(&queries_file, queries_path, type, &count);
+        void *queries = queries_loaded && type == 's' ? lines_to_rows(queries_loaded, count, queries_path) : queries_loaded;
+        double load_time = array_file_seconds() - start;
+        if (!queries) {
+            if (queries_loaded) array_file_close(&queries_file);
+            index_file_close(&file);
+            return 1;
+        }
+
+        int *results = malloc((count ? count : 1) * sizeof(int));
+        char label[32];
+        probe_count = 0;
+        start = array_file_seconds();
+        int counted = search_queries(file.payload, file.size, type, use_eytzinger ? &index : NULL, queries, count, results, label);
+        double search_time = array_file_seconds() - start;
+
+        for (int q = 0; q < count; q++) printf("%d\n", results[q]);
+        fprintf(stderr, "%d elements, %d queries (index, %s): open %.6f s, load queries %.3f s, search %.6f s (%.2f M lookups/s",
+                file.size, count, label, open_time, load_time, search_time, search_time > 0 ? count / search_time / 1e6 : 0.0);
+        if (counted) fprintf(stderr, ", %.2f probes/lookup", count ? (double)probe_count / count : 0.0);
+        fprintf(stderr, ")\n");
+        free(results);
+        if (queries != queries_loaded) free(queries);
+        array_file_close(&queries_file);
+    } else {
+        char target[STRING_LENGTH] = {0};
+        if (parse_target(type, target_text, target) != 0) {
+            index_file_close(&file);
+            return 1;
+        }
+        probe_count = 0;
+        start = array_file_seconds();
+        search_mode_t mode = resolve_search_mode(file.payload, file.size, type, search_mode);
+        int result = use_eytzinger ? eytzinger_search(&index, target) : search_with_mode(file.payload, file.size, type, target, mode, 0);
+        double search_time = array_file_seconds() - start;
+
+        char label[32];
+        mode_label(label, search_mode, mode);
+        printf("%d\n", result);
+        fprintf(stderr, "%d elements (index, %s): open %.6f s, search %.6f s", file.size, label, open_time, search_time);
+        if (!use_eytzinger && mode_counts_probes(type, mode)) fprintf(stderr, ", %lld probes", probe_count);
+        fprintf(stderr, "\n");
+    }
+
+    index_file_close(&file);
+    return 0;
+}
+
 /**
  * Prints an array of various types.
  *
@@ -285,56 +1412,46 @@ void print_array_with_range(void *arr, int size, char type, int left, int right,
 }
 
 /**
- * Bubble Sort
+ * Checks in one O(n) pass whether an array is already in ascending order, so sorting can be skipped.
  *
- * Sorts array using bubble sort algorithm.
+ * @param arr       Pointer to the array.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char[STRING_LENGTH]).
+ * @return          1 if no element is greater than the next one, 0 otherwise.
+ */
+int array_is_sorted(void *arr, int size, char type) {
+    int i = 1;
+    switch (type) {
+        case 'i': while (i < size && ((int*)arr)[i - 1] <= ((int*)arr)[i]) i++; break;
+        case 'f': while (i < size && !(((float*)arr)[i - 1] > ((float*)arr)[i])) i++; break;
+        case 'c': while (i < size && ((char*)arr)[i - 1] <= ((char*)arr)[i]) i++; break;
+        case 's': while (i < size && strcmp(((char(*)[STRING_LENGTH])arr)[i - 1], ((char(*)[STRING_LENGTH])arr)[i]) <= 0) i++; break;
+    }
+    return i >= size;
+}
+
+/**
+ * Sorts an array in O(n log n) with `qsort()` and the comparator of its type; ints are compared as
+ * ints (not through their bits as floats) and without the overflow of `a - b`.
  *
  * Supported types:
-* - 'i' for int
+ * - 'i' for int
  * - 'f' for float
  * - 'c' for char
  * - 's' for string (char[STRING_LENGTH]) - `STRING_LENGTH` is defined as 50.
  *
- * @param arr   Pointer to the array to sort.
- * @param size  Number of elements in the array.
- * @param type  Data type of the array elements:
- *                  'i' for int, 'f' for float, 'c' for char, 's' for string (char[STRING_LENGTH]).
- * @return      void
+ * @param arr       Pointer to the array to sort.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char[STRING_LENGTH]).
+ * @return          void
  */
 void sort_array(void *arr, int size, char type) {
-    for (int i = 0; i < size - 1; i++) {
-        for (int j = 0; j < size - i - 1; j++) {
-            int should_swap = 0;
-
-            switch (type) {
-                case 'i':
-                case 'f':
-                    if (((float*)arr)[j] > ((float*)arr)[j + 1]) {
-                        // Swap elements
-                        float temp = ((float*)arr)[j];
-                        ((float*)arr)[j] = ((float*)arr)[j + 1];
-                        ((float*)arr)[j + 1] = temp;
-                    }
-                    break;
-                case 'c':
-                    if (((char*)arr)[j] > ((char*)arr)[j + 1]) {
-                        // Swap elements
-                        char temp = ((char*)arr)[j];
-                        ((char*)arr)[j] = ((char*)arr)[j + 1];
-                        ((char*)arr)[j + 1] = temp;
-                    }
-                    break;
-                case 's':
-                    if (strcmp(((char(*)[STRING_LENGTH])arr)[j], ((char(*)[STRING_LENGTH])arr)[j + 1]) > 0) {
-                        // Swap elements
-                        char temp[STRING_LENGTH];
-                        strcpy(temp, ((char(*)[STRING_LENGTH])arr)[j]);
-                        strcpy(((char(*)[STRING_LENGTH])arr)[j], ((char(*)[STRING_LENGTH])arr)[j + 1]);
-                        strcpy(((char(*)[STRING_LENGTH])arr)[j + 1], temp);
-                    }
-                    break;
-                default: return;
-            }
-        }
+    switch (type) {
+        case 'i': qsort(arr, size, sizeof(int), compare_int); break;
+        case 'f': qsort(arr, size, sizeof(float), compare_float); break;
+        case 'c': qsort(arr, size, sizeof(char), compare_char); break;
+        case 's': qsort(arr, size, STRING_LENGTH, compare_string); break;
     }
 }
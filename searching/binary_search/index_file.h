@@ -0,0 +1,194 @@
+//
+// Created by Dany on 10/17/2026.
+// Copyright (c) 2026 DanyilT. All rights reserved.
+// MIT License: https://github.com/DanyilT/C/blob/main/LICENSE
+// This file is part of 'DanyilT/C' repo: https://github.com/DanyilT/C
+//
+// Index Files: Sorted Arrays Saved Once and Searched Straight from `mmap()`
+//
+
+#ifndef INDEX_FILE_H
+#define INDEX_FILE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define INDEX_FILE_MAGIC "BSINDEX" // 7 characters and the terminator fill `magic`
+#define INDEX_FILE_VERSION 1       // Bumped whenever the layout changes; other versions are refused
+#define INDEX_FILE_BYTE_ORDER 0x01020304u // Read back in another byte order, the file is refused instead of misread
+#define INDEX_FILE_ALIGN 64        // Sections start on cache line boundaries
+
+// Layout of an index file (all numbers in the byte order of the machine that wrote it):
+// - the header below, padded to `INDEX_FILE_ALIGN` bytes;
+// - payload:   `count` sorted elements of `element_size` bytes (strings are NUL-padded fixed-width rows);
+// - Eytzinger: optional ('i' and 'f' only), `count + 1` 32-bit keys in BFS order, then `count + 1` 32-bit ranks
+//              (index in the payload of each key), slot 0 of both unused; starts at `eytzinger_offset`, 0 if absent.
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    char type;             // 'i', 'f', 'c' or 's'
+    uint8_t reserved[3];
+    uint32_t element_size; // 4 for 'i' and 'f', 1 for 'c', the row width for 's'
+    uint64_t count;
+    uint64_t payload_offset;
+    uint64_t eytzinger_offset;
+} index_file_header_t;
+
+// An index opened by `index_file_open()`: pointers into a read-only mapping of the file
+typedef struct {
+    char *map;
+    size_t bytes;
+    char type;
+    int size;
+    void *payload;           // Sorted elements
+    int32_t *eytzinger_keys; // NULL without an Eytzinger block
+    int *eytzinger_rank;
+} index_file_t;
+
+static inline uint64_t index_file_align(uint64_t offset) {
+    return (offset + INDEX_FILE_ALIGN - 1) / INDEX_FILE_ALIGN * INDEX_FILE_ALIGN;
+}
+
+/**
+ * Writes all of a buffer to a file descriptor, retrying short writes.
+ *
+ * @param fd        Open file descriptor.
+ * @param data      Bytes to write.
+ * @param bytes     Number of bytes.
+ * @return          1 on success, 0 on error.
+ */
+static inline int index_file_write_all(int fd, const void *data, size_t bytes) {
+    const char *p = data;
+    while (bytes > 0) {
+        ssize_t written = write(fd, p, bytes);
+        if (written <= 0) return 0;
+        p += written;
+        bytes -= (size_t)written;
+    }
+    return 1;
+}
+
+/**
+ * Writes a sorted array (and optionally its Eytzinger layout) as an index file.
+ *
+ * @param path          Output file.
+ * @param type          'i', 'f', 'c' or 's'.
+ * @param element_size  Bytes per element.
+ * @param sorted        Sorted elements.
+ * @param count         Number of elements.
+ * @param keys          Eytzinger keys (`count + 1` slots, slot 0 unused), NULL for none.
+ * @param rank          Payload index of every Eytzinger key (`count + 1` slots).
+ * @return              0 on success, 1 on error (message printed to stderr).
+ */
+static inline int index_file_write(const char *path, char type, size_t element_size, const void *sorted, int count,
+                                   const int32_t *keys, const int *rank) {
+    static const char padding[INDEX_FILE_ALIGN] = {0};
+    index_file_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, INDEX_FILE_MAGIC, sizeof(header.magic));
+    header.version = INDEX_FILE_VERSION;
+    header.byte_order = INDEX_FILE_BYTE_ORDER;
+    header.type = type;
+    header.element_size = (uint32_t)element_size;
+    header.count = (uint64_t)count;
+    header.payload_offset = index_file_align(sizeof(header));
+    uint64_t payload_end = header.payload_offset + (uint64_t)count * element_size;
+    header.eytzinger_offset = keys ? index_file_align(payload_end) : 0;
+
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    int ok = fd >= 0
+             && index_file_write_all(fd, &header, sizeof(header))
+             && index_file_write_all(fd, padding, header.payload_offset - sizeof(header))
+             && index_file_write_all(fd, sorted, (size_t)count * element_size);
+    if (ok && keys)
+        ok = index_file_write_all(fd, padding, header.eytzinger_offset - payload_end)
+             && index_file_write_all(fd, keys, ((size_t)count + 1) * sizeof(int32_t))
+             && index_file_write_all(fd, rank, ((size_t)count + 1) * sizeof(int));
+    if (fd >= 0 && close(fd) != 0) ok = 0;
+
+    if (!ok) fprintf(stderr, "Cannot write index file '%s'!\n", path);
+    return !ok;
+}
+
+/**
+ * Opens an index file: maps it read-only and checks the header and section bounds. Nothing is read
+ * or copied up front; pages are faulted in as searches touch them.
+ *
+ * @param index         Receives the mapping; release it with `index_file_close()`.
+ * @param path          Index file written by `index_file_write()`.
+ * @param string_width  Row width the program uses for 's' (the file must match it).
+ * @return              0 on success, 1 on error (message printed to stderr).
+ */
+static inline int index_file_open(index_file_t *index, const char *path, size_t string_width) {
+    memset(index, 0, sizeof(*index));
+    int fd = open(path, O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0) {
+        fprintf(stderr, "Cannot open index file '%s'!\n", path);
+        if (fd >= 0) close(fd);
+        return 1;
+    }
+    index->bytes = (size_t)info.st_size;
+    if (index->bytes < sizeof(index_file_header_t)) {
+        fprintf(stderr, "'%s' is not an index file!\n", path);
+        close(fd);
+        return 1;
+    }
+    index->map = mmap(NULL, index->bytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (index->map == MAP_FAILED) {
+        fprintf(stderr, "Cannot map index file '%s'!\n", path);
+        index->map = NULL;
+        return 1;
+    }
+
+    index_file_header_t header;
+    memcpy(&header, index->map, sizeof(header));
+    const char *problem = NULL;
+    size_t width = header.type == 's' ? string_width : header.type == 'c' ? 1 : 4;
+    if (memcmp(header.magic, INDEX_FILE_MAGIC, sizeof(header.magic)) != 0) problem = "is not an index file";
+    else if (header.version != INDEX_FILE_VERSION) problem = "has an unsupported index version";
+    else if (header.byte_order != INDEX_FILE_BYTE_ORDER) problem = "was written with another byte order";
+    else if (!strchr("ifcs", header.type) || header.type == '\0' || header.element_size != width) problem = "has an unsupported element type or width";
+    else if (header.count > 0x7fffffff) problem = "has more elements than an int can count";
+    else if (header.payload_offset % INDEX_FILE_ALIGN != 0 || header.payload_offset > index->bytes
+             || (index->bytes - header.payload_offset) / width < header.count) problem = "is truncated";
+    else if (header.eytzinger_offset != 0
+             && (header.type == 'c' || header.type == 's' || header.eytzinger_offset % INDEX_FILE_ALIGN != 0
+                 || header.eytzinger_offset > index->bytes
+                 || (index->bytes - header.eytzinger_offset) / sizeof(int32_t) < 2 * header.count + 2)) problem = "has a damaged Eytzinger block";
+    if (problem) {
+        fprintf(stderr, "'%s' %s!\n", path, problem);
+        munmap(index->map, index->bytes);
+        index->map = NULL;
+        return 1;
+    }
+
+    index->type = header.type;
+    index->size = (int)header.count;
+    index->payload = index->map + header.payload_offset;
+    if (header.eytzinger_offset) {
+        index->eytzinger_keys = (int32_t*)(index->map + header.eytzinger_offset);
+        index->eytzinger_rank = (int*)(index->eytzinger_keys + header.count + 1);
+    }
+    return 0;
+}
+
+/**
+ * Unmaps an index file.
+ *
+ * @param index     Index opened by `index_file_open()`.
+ * @return          void
+ */
+static inline void index_file_close(index_file_t *index) {
+    if (index->map) munmap(index->map, index->bytes);
+    memset(index, 0, sizeof(*index));
+}
+
+#endif // INDEX_FILE_H
@@ -12,6 +12,8 @@
 #include <string.h>
 #include <time.h>
 #include "ansi_colors.h" // Include ANSI color codes for console output (custom header file)
+#include "array_file.h" // Binary and line-delimited array files for `--in` (custom header file)
+#include "text_reader.h" // Buffered `read()` input with a SWAR number parser for the prompts (custom header file)
 
 #define STRING_LENGTH 50
 #define MAX_ATTEMPTS 1000
@@ -19,13 +21,25 @@
 int random_search(void *arr, int size, char type, void *target, int visualize);
 void print_array(void *arr, int size, char type);
 void print_array_with_highlight(void *arr, int size, char type, int highlight_index);
+int parse_target(char type, const char *text, char *target);
+char *lines_to_rows(char **lines, int count, const char *what);
+int search_array_file(const char *input_path, const char *format, const char *target_text);
 
 int main(int argc, char *argv[]) {
     srand(time(NULL)); // Initialize random seed
 
     int visualize = 0;
-    if (argc > 1) if (strcmp(argv[1], "-v") == 0 || strcmp(argv[1], "--visualize") == 0) visualize = 1; // Enable visualization if -v or --visualize is passed
+    const char *input_path = NULL, *format = NULL, *target_text = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0 || strcmp(argv[i], "--visualize") == 0) visualize = 1; // Enable visualization if -v or --visualize is passed
+        else if (strcmp(argv[i], "--in") == 0 && i + 1 < argc) input_path = argv[++i]; // Search an array file instead of prompting (needs --format and --target)
+        else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) format = argv[++i]; // Array file format: i32, f32, u8 or lines
+        else if (strcmp(argv[i], "--target") == 0 && i + 1 < argc) target_text = argv[++i]; // Value to search for in the --in file
+    }
+
+    if (input_path) return search_array_file(input_path, format, target_text);
 
+    setvbuf(stdin, NULL, _IONBF, 0); // The number prompts read stdin with `read()` (text_reader.h), so stdio must not read ahead
     int choice;
     printf(MAGENTA "Random Search\n");
     printf("=============\n" RESET);
@@ -53,12 +67,15 @@ int main(int argc, char *argv[]) {
             arr = malloc(size * sizeof(int));
             target = malloc(sizeof(int));
 
+            text_reader_t reader;
+            text_reader_open(&reader, STDIN_FILENO);
             printf("Enter %d integers: ", size);
-            for (int i = 0; i < size; i++) scanf("%*[^0-9]%d", &((int*)arr)[i]);
-            while (getchar() != '\n'); // Clear input buffer
+            for (int i = 0; i < size; i++) text_reader_int(&reader, &((int*)arr)[i]);
+            text_reader_skip_line(&reader); // Clear input buffer
 
             printf("Enter target integer: ");
-            scanf("%d", (int*) target);
+            text_reader_int(&reader, (int*) target);
+            text_reader_close(&reader);
             break;
         }
         // For floats
@@ -67,12 +84,15 @@ int main(int argc, char *argv[]) {
             arr = malloc(size * sizeof(float));
             target = malloc(sizeof(float));
 
+            text_reader_t reader;
+            text_reader_open(&reader, STDIN_FILENO);
             printf("Enter %d floats: ", size);
-            for (int i = 0; i < size; i++) scanf("%*[^0-9.]%f", &((float*)arr)[i]);
-            while (getchar() != '\n'); // Clear input buffer
+            for (int i = 0; i < size; i++) text_reader_float(&reader, &((float*)arr)[i]);
+            text_reader_skip_line(&reader); // Clear input buffer
 
             printf("Enter target float: ");
-            scanf("%f", (float*) target);
+            text_reader_float(&reader, (float*) target);
+            text_reader_close(&reader);
             break;
         }
         // For characters
@@ -239,6 +259,97 @@ int random_search(void *arr, int size, char type, void *target, int visualize) {
     return -1; // Element not found (after MAX_ATTEMPTS)
 }
 
+/**
+ * Parses a `--target` value as the element type of an array.
+ *
+ * @param type      'i', 'f', 'c' or 's'.
+ * @param text      Target value as text.
+ * @param target    Receives the value (`STRING_LENGTH` bytes, zero-filled by the caller).
+ * @return          0 on success, 1 if a string target is too long (message printed to stderr).
+ */
+int parse_target(char type, const char *text, char *target) {
+    switch (type) {
+        case 'i': *(int*)target = (int)strtol(text, NULL, 10); break;
+        case 'f': *(float*)target = strtof(text, NULL); break;
+        case 'c': target[0] = text[0]; break;
+        case 's':
+            if (strlen(text) >= STRING_LENGTH) {
+                fprintf(stderr, "Target is longer than %d characters!\n", STRING_LENGTH - 1);
+                return 1;
+            }
+            strcpy(target, text);
+            break;
+    }
+    return 0;
+}
+
+/**
+ * Copies lines into `STRING_LENGTH`-byte rows, the string layout of `random_search()`.
+ *
+ * @param lines     Lines loaded by `array_file_load()`.
+ * @param count     Number of lines.
+ * @param what      File the lines come from, for the error message.
+ * @return          Newly allocated rows (free with `free()`), NULL if a line is too long.
+ */
+char *lines_to_rows(char **lines, int count, const char *what) {
+    char (*rows)[STRING_LENGTH] = calloc(count ? count : 1, STRING_LENGTH);
+    for (int i = 0; i < count; i++) {
+        if (strlen(lines[i]) >= STRING_LENGTH) {
+            fprintf(stderr, "%s line %d is longer than %d characters!\n", what, i + 1, STRING_LENGTH - 1);
+            free(rows);
+            return NULL;
+        }
+        strcpy(rows[i], lines[i]);
+    }
+    return (char*)rows;
+}
+
+/**
+ * Loads an array file and searches it for one target, without any prompts.
+ *
+ * Prints the index of the target (or -1) to stdout and the phase timings (and the attempts of a miss)
+ * to stderr. The array is searched as it is, unsorted; lines are copied into `STRING_LENGTH`-byte rows first.
+ *
+ * @param input_path  Array file to search.
+ * @param format      "i32", "f32", "u8" or "lines".
+ * @param target_text Target value as text (parsed as the file's element type).
+ * @return            0 on success, 1 on error.
+ */
+int search_array_file(const char *input_path, const char *format, const char *target_text) {
+    char type = array_file_type(format);
+    if (!type || !target_text) {
+        fprintf(stderr, "--in needs --format i32, f32, u8 or lines and --target VALUE!\n");
+        return 1;
+    }
+
+    array_file_t file;
+    int size;
+    double start = array_file_seconds();
+    void *loaded = array_file_load(&file, input_path, type, &size);
+    if (!loaded) return 1;
+
+    void *arr = loaded;
+    char target[STRING_LENGTH] = {0};
+    if (parse_target(type, target_text, target) != 0 || (type == 's' && !(arr = lines_to_rows(loaded, size, input_path)))) {
+        array_file_close(&file);
+        return 1;
+    }
+    double load_time = array_file_seconds() - start;
+
+    start = array_file_seconds();
+    int result = size > 0 ? random_search(arr, size, type, target, 0) : -1;
+    double search_time = array_file_seconds() - start;
+
+    printf("%d\n", result < 0 ? -1 : result); // A miss comes back as minus the number of attempts
+    fprintf(stderr, "%d elements (%s): load %.3f s, search %.6f s", size, format, load_time, search_time);
+    if (result < 0 && size > 0) fprintf(stderr, ", not found after %d attempts", -result);
+    fprintf(stderr, "\n");
+
+    if (arr != loaded) free(arr);
+    array_file_close(&file);
+    return 0;
+}
+
 /**
  * Prints an array of various types without highlighting.
  *
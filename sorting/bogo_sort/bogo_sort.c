@@ -10,27 +10,86 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
+#include <stdint.h>
 #include <time.h>
+#include <pthread.h>
 #include "ansi_colors.h" // Include ANSI color codes for console output (custom header file)
+#include "array_file.h" // Binary and line-delimited array files for `--in` / `--out` (custom header file)
+#include "text_reader.h" // Buffered `read()` input with a SWAR number parser for the prompts (custom header file)
+#include "rng.h" // Seedable xoshiro256** and PCG32 generators with unbiased bounded ranges (custom header file)
 
-#define STRING_LENGTH 50
 #define MAX_SHUFFLES 1000000
+#define BENCHMARK_SHUFFLES 2000000 // Shuffles timed per generator by `--benchmark`
+#define DEFAULT_BENCHMARK_SIZE 8   // Array size of `--benchmark` without an argument
+
+// One shuffler of the parallel mode: shuffles its own copy of the array with its own generator stream
+typedef struct {
+    void *arr;          // Private copy (for strings: of the pointers, the arena is shared read-only)
+    int size;
+    char type;
+    rng_t rng;
+    int id;
+    long long limit;    // Shuffles this thread may try
+    long long shuffles; // Shuffles it did try
+    int *winner;        // Shared: id of the first thread that found sorted order, -1 until then
+} shuffler_t;
+
+FILE *progress_stream; // Where `bogo_sort()` reports progress: stdout, or stderr when stdout carries the sorted `--in` file
+uint64_t seed; // Seed of every generator (`--seed S`, default: the current time)
+rng_kind_t rng_kind = RNG_XOSHIRO; // Generator used by the shuffles (`--rng xoshiro|pcg`)
+int thread_count = 1; // Shufflers racing on their own copies (`--threads N`)
 
 void bogo_sort(void *arr, int size, char type, int visualize);
+long long bogo_sort_parallel(void *arr, int size, char type, int threads);
+void *shuffler_thread(void *arg);
 int is_sorted(void *arr, int size, char type, char order);
-void shuffle_array(void *arr, int size, char type);
+int shuffle_array(void *arr, int size, char type, rng_t *rng, int early_exit);
+void sort_file_array(void *arr, int size, char type);
+void run_benchmark(int size);
+double now_seconds(void);
 void print_array(void *arr, int size, char type);
+char **read_strings(int size, char **arena);
 
 int main(int argc, char *argv[]) {
-    srand(time(NULL)); // Initialize random seed
+    seed = (uint64_t)time(NULL); // Default seed, printed so the run can be repeated with `--seed`
 
     int visualize = 0;
-    if (argc > 1) if (strcmp(argv[1], "-v") == 0 || strcmp(argv[1], "--visualize") == 0) visualize = 1; // Enable visualization if -v or --visualize is passed
+    int benchmark_size = 0;
+    const char *input_path = NULL, *output_path = NULL, *format = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0 || strcmp(argv[i], "--visualize") == 0) visualize = 1; // Enable visualization if -v or --visualize is passed
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = strtoull(argv[++i], NULL, 0); // Reproducible shuffles
+        else if (strcmp(argv[i], "--rng") == 0 && i + 1 < argc) { // Generator: xoshiro (default) or pcg
+            int kind = rng_kind_from_name(argv[++i]);
+            if (kind < 0) {
+                fprintf(stderr, "--rng needs xoshiro or pcg!\n");
+                return 1;
+            }
+            rng_kind = kind;
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) thread_count = atoi(argv[++i]) > 0 ? atoi(argv[i]) : 1; // Race N shufflers
+        else if (strcmp(argv[i], "--benchmark") == 0) benchmark_size = i + 1 < argc && atoi(argv[i + 1]) > 0 ? atoi(argv[++i]) : DEFAULT_BENCHMARK_SIZE; // Shuffles per second of every generator
+        else if (strcmp(argv[i], "--in") == 0 && i + 1 < argc) input_path = argv[++i]; // Sort an array file instead of prompting (needs --format)
+        else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) output_path = argv[++i]; // Output file of --in (default: stdout)
+        else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) format = argv[++i]; // Array file format: i32, f32, u8 or lines
+    }
 
+    progress_stream = input_path ? stderr : stdout;
+    if (input_path) return sort_array_file(input_path, output_path, format, sort_file_array);
+
+    if (benchmark_size > 0) {
+        run_benchmark(benchmark_size);
+        return 0;
+    }
+
+    setvbuf(stdin, NULL, _IONBF, 0); // The number prompts read stdin with `read()` (text_reader.h), so stdio must not read ahead
     int choice;
     printf(MAGENTA "Bogo Sort\n");
     printf("=========\n" RESET);
     if (visualize) printf(BG_YELLOW "Visualization enabled." RESET "\n");
+    if (thread_count > 1) printf(BG_YELLOW "%d shufflers enabled." RESET "\n", thread_count);
+    if (thread_count > 1 && visualize) printf(YELLOW "Parallel shufflers are not visualized, using one shuffler.\n" RESET);
     printf(RED "⚠ WARNING: " YELLOW "Bogo Sort is extremely inefficient! Use small arrays only.\n" RESET);
     printf("Choose data type:\n");
     printf("1. Integers\n");
@@ -57,6 +116,7 @@ int main(int argc, char *argv[]) {
 
     char type = 0;
     void *arr = NULL;
+    char *arena = NULL; // Backing storage of the strings when sorting 's' (`arr` then holds pointers into it)
 
     switch(choice) {
         // For integers
@@ -64,9 +124,12 @@ int main(int argc, char *argv[]) {
             type = 'i';
             arr = malloc(size * sizeof(int));
 
+            text_reader_t reader;
+            text_reader_open(&reader, STDIN_FILENO);
             printf("Enter %d integers: ", size);
-            for (int i = 0; i < size; i++) scanf("%*[^0-9]%d", &((int*)arr)[i]);
-            while (getchar() != '\n'); // Clear input buffer
+            for (int i = 0; i < size; i++) text_reader_int(&reader, &((int*)arr)[i]);
+            text_reader_skip_line(&reader); // Clear input buffer
+            text_reader_close(&reader);
             break;
         }
         // For floats
@@ -74,9 +137,12 @@ int main(int argc, char *argv[]) {
             type = 'f';
             arr = malloc(size * sizeof(float));
 
+            text_reader_t reader;
+            text_reader_open(&reader, STDIN_FILENO);
             printf("Enter %d floats: ", size);
-            for (int i = 0; i < size; i++) scanf("%*[^0-9.]%f", &((float*)arr)[i]);
-            while (getchar() != '\n'); // Clear input buffer
+            for (int i = 0; i < size; i++) text_reader_float(&reader, &((float*)arr)[i]);
+            text_reader_skip_line(&reader); // Clear input buffer
+            text_reader_close(&reader);
             break;
         }
         // For characters
@@ -92,10 +158,9 @@ int main(int argc, char *argv[]) {
         // For strings
         case 4: {
             type = 's';
-            arr = malloc(size * STRING_LENGTH * sizeof(char));
 
             printf("Enter %d strings: ", size);
-            for (int i = 0; i < size; i++) scanf("%s", ((char(*)[STRING_LENGTH])arr)[i]);
+            arr = read_strings(size, &arena);
             while (getchar() != '\n'); // Clear input buffer
             break;
         }
@@ -123,6 +188,7 @@ int main(int argc, char *argv[]) {
     printf(RESET);
 
     free(arr);
+    free(arena);
     return 0;
 }
 
@@ -134,40 +200,142 @@ int main(int argc, char *argv[]) {
  * - 'i' for int
  * - 'f' for float
  * - 'c' for char
- * - 's' for string (char[STRING_LENGTH]) - `STRING_LENGTH` is defined as 50.
+ * - 's' for string (char*) - pointers into one string arena, strings of any length.
  *
  * @param arr       Pointer to the array to sort.
  * @param size      Number of elements in the array.
  * @param type      Data type of the array elements:
- *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char[STRING_LENGTH]).
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
  * @param visualize Flag to enable step-by-step visualization. (1 = enable, 0 = disable)
  * @return          void
  */
 void bogo_sort(void *arr, int size, char type, int visualize) {
     if (visualize) printf(BOLD "\nStep-by-step sorting:\n" RESET);
+    fprintf(progress_stream, DIM "Seed %llu (%s)\n" RESET, (unsigned long long)seed, rng_names[rng_kind]);
 
-    int shuffle_count = 0;
-    while (!is_sorted(arr, size, type, 'a') && shuffle_count < MAX_SHUFFLES) {
-        shuffle_array(arr, size, type);
-        shuffle_count++;
+    double start = now_seconds();
+    long long shuffle_count = 0;
+    if (thread_count > 1 && !visualize) shuffle_count = bogo_sort_parallel(arr, size, type, thread_count);
+    else {
+        rng_t rng;
+        rng_seed(&rng, rng_kind, seed, 0);
+        int sorted = is_sorted(arr, size, type, 'a');
+        while (!sorted && shuffle_count < MAX_SHUFFLES) {
+            sorted = shuffle_array(arr, size, type, &rng, !visualize); // Visualized shuffles are shown complete
+            shuffle_count++;
 
-        if (visualize) {
-            printf("Shuffle %d: ", shuffle_count);
-            print_array(arr, size, type);
-            if (is_sorted(arr, size, type, 'a')) printf(GREEN "    ✓ SORTED!\n" RESET); else printf(RED "    ✗ Not sorted\n" RESET);
-        }
+            if (visualize) {
+                printf("Shuffle %lld: ", shuffle_count);
+                print_array(arr, size, type);
+                if (sorted) printf(GREEN "    ✓ SORTED!\n" RESET); else printf(RED "    ✗ Not sorted\n" RESET);
+            }
 
-        // For very large shuffle counts, show progress periodically
-        if (!visualize && shuffle_count % 10000 == 0) {
-            printf("Shuffles attempted: %d...\n", shuffle_count);
+            // For very large shuffle counts, show progress periodically
+            if (!visualize && shuffle_count % 10000 == 0) {
+                fprintf(progress_stream, "Shuffles attempted: %lld...\n", shuffle_count);
+            }
         }
     }
+    double elapsed = now_seconds() - start;
 
-    if (shuffle_count >= MAX_SHUFFLES) {
-        printf(RED "  ⚠ Maximum shuffles (%d) reached! Array may not be sorted.\n" RESET, MAX_SHUFFLES);
+    if (!is_sorted(arr, size, type, 'a')) {
+        fprintf(progress_stream, RED "  ⚠ Maximum shuffles (%d) reached! Array may not be sorted.\n" RESET, MAX_SHUFFLES);
     } else {
-        printf(GREEN "  ✓ Array sorted after %d shuffle%s!\n" RESET, shuffle_count, shuffle_count == 1 ? "" : "s");
+        fprintf(progress_stream, GREEN "  ✓ Array sorted after %lld shuffle%s!\n" RESET, shuffle_count, shuffle_count == 1 ? "" : "s");
     }
+    if (!visualize && elapsed > 0)
+        fprintf(progress_stream, DIM "  %.3f s, %.0f shuffles/s\n" RESET, elapsed, shuffle_count / elapsed);
+}
+
+/**
+ * Races `threads` shufflers: each shuffles its own copy of the array with its own generator stream
+ * (stream = thread index, so a seed still fixes every thread's sequence) and the first to hit sorted
+ * order wins; the others stop at their next shuffle. `MAX_SHUFFLES` is split between the threads.
+ * The calling thread is shuffler 0.
+ *
+ * Supported types:
+ * - 'i' for int
+ * - 'f' for float
+ * - 'c' for char
+ * - 's' for string (char*) - pointers into one string arena, strings of any length.
+ *
+ * @param arr       Pointer to the array to sort; receives the winner's copy.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @param threads   Number of shufflers.
+ * @return          Total number of shuffles of all threads.
+ */
+long long bogo_sort_parallel(void *arr, int size, char type, int threads) {
+    if (is_sorted(arr, size, type, 'a')) return 0;
+
+    size_t width = type == 'i' ? sizeof(int) : type == 'f' ? sizeof(float) : type == 'c' ? sizeof(char) : sizeof(char*);
+    pthread_t *ids = malloc(threads * sizeof(pthread_t));
+    int *started = calloc(threads, sizeof(int));
+    shuffler_t *shufflers = calloc(threads, sizeof(shuffler_t));
+    int winner = -1;
+
+    for (int t = 0; t < threads; t++) {
+        shufflers[t].arr = malloc(size * width);
+        memcpy(shufflers[t].arr, arr, size * width);
+        shufflers[t].size = size;
+        shufflers[t].type = type;
+        rng_seed(&shufflers[t].rng, rng_kind, seed, t);
+        shufflers[t].id = t;
+        shufflers[t].limit = MAX_SHUFFLES / threads + (t < MAX_SHUFFLES % threads);
+        shufflers[t].winner = &winner;
+    }
+    // A shuffler whose thread cannot be created just sits the race out (its share of shuffles is not run)
+    for (int t = 1; t < threads; t++) started[t] = pthread_create(&ids[t], NULL, shuffler_thread, &shufflers[t]) == 0;
+    shuffler_thread(&shufflers[0]);
+    for (int t = 1; t < threads; t++) if (started[t]) pthread_join(ids[t], NULL);
+
+    // Without a winner every copy is just its last shuffle; keep shuffler 0's
+    memcpy(arr, shufflers[winner >= 0 ? winner : 0].arr, size * width);
+    long long total = 0;
+    for (int t = 0; t < threads; t++) {
+        total += shufflers[t].shuffles;
+        free(shufflers[t].arr);
+    }
+    if (winner >= 0) fprintf(progress_stream, "Shuffler %d of %d won.\n", winner + 1, threads);
+    free(ids);
+    free(started);
+    free(shufflers);
+    return total;
+}
+
+/**
+ * pthread entry of a shuffler: shuffles its copy until it is sorted, another shuffler has won, or
+ * its share of `MAX_SHUFFLES` is used up.
+ *
+ * @param arg       Pointer to the thread's `shuffler_t`.
+ * @return          NULL
+ */
+void *shuffler_thread(void *arg) {
+    shuffler_t *shuffler = arg;
+    while (shuffler->shuffles < shuffler->limit && __atomic_load_n(shuffler->winner, __ATOMIC_RELAXED) < 0) {
+        shuffler->shuffles++;
+        if (shuffle_array(shuffler->arr, shuffler->size, shuffler->type, &shuffler->rng, 1)) {
+            int none = -1; // Only the first finisher becomes the winner
+            __atomic_compare_exchange_n(shuffler->winner, &none, shuffler->id, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+            break;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Sorts an array loaded by `--in` (never visualized). Gives up after `MAX_SHUFFLES` like `bogo_sort()`,
+ * in which case the last shuffle is written.
+ *
+ * @param arr       Pointer to the array to sort.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @return          void
+ */
+void sort_file_array(void *arr, int size, char type) {
+    bogo_sort(arr, size, type, 0);
 }
 
 /**
@@ -177,12 +345,12 @@ void bogo_sort(void *arr, int size, char type, int visualize) {
  * - 'i' for int
  * - 'f' for float
  * - 'c' for char
- * - 's' for string (char[STRING_LENGTH]) - `STRING_LENGTH` is defined as 50.
+ * - 's' for string (char*) - pointers into one string arena, strings of any length.
  *
  * @param arr       Pointer to the array to check.
  * @param size      Number of elements in the array.
  * @param type      Data type of the array elements:
- *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char[STRING_LENGTH]).
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
  * @param order     Sorting order ('a' for ascending, 'd' for descending).
  * @return          1 if sorted, 0 if not sorted.
  */
@@ -202,8 +370,8 @@ int is_sorted(void *arr, int size, char type, char order) {
                 if (order == 'd') if (((char *)arr)[i] < ((char *)arr)[i + 1]) return 0;
                 break;
             case 's': // String
-                if (order == 'a') if (strcmp(((char (*)[STRING_LENGTH])arr)[i], ((char (*)[STRING_LENGTH])arr)[i + 1]) > 0) return 0;
-                if (order == 'd') if (strcmp(((char (*)[STRING_LENGTH])arr)[i], ((char (*)[STRING_LENGTH])arr)[i + 1]) < 0) return 0;
+                if (order == 'a') if (strcmp(((char**)arr)[i], ((char**)arr)[i + 1]) > 0) return 0;
+                if (order == 'd') if (strcmp(((char**)arr)[i], ((char**)arr)[i + 1]) < 0) return 0;
                 break;
             default:
                 return 0; // Unknown type
@@ -213,57 +381,161 @@ int is_sorted(void *arr, int size, char type, char order) {
 }
 
 /**
- * Randomly shuffles an array using Fisher-Yates shuffle algorithm.
+ * Randomly shuffles an array using Fisher-Yates shuffle algorithm, and checks on the way whether the
+ * result is sorted in ascending order.
  *
- * Set the seed for random number generation using `srand(time(NULL))` before calling this function.
+ * Every swap position comes from `rng_bounded()`, so all n! orders are equally likely (`rand() % (i + 1)`
+ * was biased towards small positions) and each thread can shuffle with its own generator.
+ *
+ * Fisher-Yates fixes the array from the back: once `arr[i]` is drawn it never moves again, and
+ * `arr[i + 1]` is already final, so the pair is compared right there instead of in a separate
+ * `is_sorted()` pass. With `early_exit` the shuffle stops at the first inversion: that attempt can no
+ * longer succeed, and the next shuffle is uniform whatever order it starts from, so the chance of
+ * success per shuffle stays 1/n! while most attempts end after a couple of draws.
  *
  * Supported types:
  * - 'i' for int
  * - 'f' for float
  * - 'c' for char
- * - 's' for string (char[STRING_LENGTH]) - `STRING_LENGTH` is defined as 50.
+ * - 's' for string (char*) - pointers into one string arena, strings of any length.
  *
- * @param arr       Pointer to the array to shuffle.
- * @param size      Number of elements in the array.
- * @param type      Data type of the array elements:
- *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char[STRING_LENGTH]).
+ * @param arr        Pointer to the array to shuffle.
+ * @param size       Number of elements in the array.
+ * @param type       Data type of the array elements:
+ *                       'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @param rng        Generator to draw the positions from (seeded with `rng_seed()`).
+ * @param early_exit Stop at the first inversion (1), or always finish the shuffle (0).
+ * @return           1 if the shuffled array is sorted, 0 if not (or if the shuffle stopped early).
+ */
+int shuffle_array(void *arr, int size, char type, rng_t *rng, int early_exit) {
+    // Draw arr[i], swap it in, then compare it with the final arr[i + 1]; arr[0] is final after the loop
+    #define SHUFFLE_AND_CHECK(T, greater) {                                         \
+        T *a = arr;                                                                 \
+        int sorted = 1;                                                             \
+        for (int i = size - 1; i > 0; i--) {                                        \
+            int j = (int)rng_bounded(rng, (uint32_t)(i + 1));                       \
+            T temp = a[i];                                                          \
+            a[i] = a[j];                                                            \
+            a[j] = temp;                                                            \
+            if (i < size - 1 && greater(a[i], a[i + 1])) {                          \
+                if (early_exit) return 0;                                           \
+                sorted = 0;                                                         \
+            }                                                                       \
+        }                                                                           \
+        return sorted && (size < 2 || !greater(a[0], a[1]));                        \
+    }
+    #define NUMBER_GREATER(x, y) ((x) > (y))
+    #define STRING_GREATER(x, y) (strcmp((x), (y)) > 0) // Pointers are swapped, the strings stay in the arena
+
+    switch (type) {
+        case 'i': SHUFFLE_AND_CHECK(int, NUMBER_GREATER)
+        case 'f': SHUFFLE_AND_CHECK(float, NUMBER_GREATER)
+        case 'c': SHUFFLE_AND_CHECK(char, NUMBER_GREATER)
+        case 's': SHUFFLE_AND_CHECK(char*, STRING_GREATER)
+        default: return 0; // Unknown type
+    }
+
+    #undef SHUFFLE_AND_CHECK
+    #undef NUMBER_GREATER
+    #undef STRING_GREATER
+}
+
+/**
+ * Measures bogo sort attempts per second on an int array: the old `rand() % (i + 1)` shuffle followed
+ * by `is_sorted()`, and every `rng.h` generator both that way and with the fused early-exit check of
+ * `shuffle_array()`. Single-threaded.
+ *
+ * @param size      Number of elements to shuffle (at least 2).
  * @return          void
  */
-void shuffle_array(void *arr, int size, char type) {
-    for (int i = size - 1; i > 0; i--) {
-        int j = rand() % (i + 1);
+void run_benchmark(int size) {
+    if (size < 2) size = 2;
+    int *arr = malloc(size * sizeof(int));
+    for (int i = 0; i < size; i++) arr[i] = i;
 
-        // Swap elements at positions i and j
-        switch (type) {
-            case 'i': {
-                int temp = ((int *)arr)[i];
-                ((int *)arr)[i] = ((int *)arr)[j];
-                ((int *)arr)[j] = temp;
-                break;
-            }
-            case 'f': {
-                float temp = ((float *)arr)[i];
-                ((float *)arr)[i] = ((float *)arr)[j];
-                ((float *)arr)[j] = temp;
-                break;
-            }
-            case 'c': {
-                char temp = ((char *)arr)[i];
-                ((char *)arr)[i] = ((char *)arr)[j];
-                ((char *)arr)[j] = temp;
-                break;
-            }
-            case 's': {
-                char temp[STRING_LENGTH];
-                strcpy(temp, ((char (*)[STRING_LENGTH])arr)[i]);
-                strcpy(((char (*)[STRING_LENGTH])arr)[i], ((char (*)[STRING_LENGTH])arr)[j]);
-                strcpy(((char (*)[STRING_LENGTH])arr)[j], temp);
-                break;
+    printf(MAGENTA "Bogo Sort Shuffle Benchmark\n");
+    printf("===========================\n" RESET);
+    printf("%d shuffles of %d ints per row, seed %llu\n", BENCHMARK_SHUFFLES, size, (unsigned long long)seed);
+    printf(BOLD "\n%-18s %-20s %14s %9s\n" RESET, "Generator", "Check", "Shuffles/s", "Speedup");
+
+    double baseline = 0;
+    for (int g = -1; g < RNG_KIND_COUNT; g++) {
+        for (int fused = 0; fused <= (g >= 0); fused++) {
+            rng_t rng;
+            if (g >= 0) rng_seed(&rng, (rng_kind_t)g, seed, 0);
+            else srand((unsigned)seed);
+
+            long long sorted = 0; // Keeps the checks from being optimized away
+            double start = now_seconds();
+            for (int r = 0; r < BENCHMARK_SHUFFLES; r++) {
+                if (fused) sorted += shuffle_array(arr, size, 'i', &rng, 1);
+                else {
+                    if (g >= 0) shuffle_array(arr, size, 'i', &rng, 0);
+                    else for (int i = size - 1; i > 0; i--) { // The old shuffle
+                        int j = rand() % (i + 1);
+                        int temp = arr[i];
+                        arr[i] = arr[j];
+                        arr[j] = temp;
+                    }
+                    sorted += is_sorted(arr, size, 'i', 'a');
+                }
             }
-            default:
-                return; // Unknown type
+            double rate = BENCHMARK_SHUFFLES / (now_seconds() - start);
+            if (g < 0) baseline = rate;
+            printf("%-18s %-20s %14.0f %8.2fx   (%lld sorted)\n", g < 0 ? "rand() % (i + 1)" : rng_names[g],
+                   fused ? "fused, early exit" : "shuffle + is_sorted", rate, rate / baseline, sorted);
+        }
+    }
+    free(arr);
+}
+
+/**
+ * Returns a monotonic timestamp in seconds, used for the shuffle rate.
+ *
+ * @return          Current monotonic time in seconds.
+ */
+double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Reads whitespace-separated strings of any length from standard input into one arena.
+ *
+ * All characters are appended back to back (each string NUL-terminated) to a single growing buffer,
+ * and the returned array holds one pointer per string into it. Sorting then only moves pointers.
+ * The character that ends the last string is pushed back, so the caller can still clear the line.
+ *
+ * @param size      Number of strings to read.
+ * @param arena     Receives the arena holding the characters. Free it after the pointer array.
+ * @return          Array of `size` pointers into the arena.
+ */
+char **read_strings(int size, char **arena) {
+    size_t capacity = 256, used = 0;
+    size_t *offsets = malloc(size * sizeof(size_t)); // Offsets, because the arena may move while growing
+    *arena = malloc(capacity);
+
+    int c = EOF;
+    for (int i = 0; i < size; i++) {
+        c = getchar();
+        while (c != EOF && isspace(c)) c = getchar();
+
+        offsets[i] = used;
+        while (1) {
+            if (used + 1 >= capacity) *arena = realloc(*arena, capacity *= 2);
+            if (c == EOF || isspace(c)) break;
+            (*arena)[used++] = (char)c;
+            c = getchar();
         }
+        (*arena)[used++] = '\0';
     }
+    if (c != EOF) ungetc(c, stdin);
+
+    char **strings = malloc(size * sizeof(char*));
+    for (int i = 0; i < size; i++) strings[i] = *arena + offsets[i];
+    free(offsets);
+    return strings;
 }
 
 /**
@@ -273,12 +545,12 @@ void shuffle_array(void *arr, int size, char type) {
  * - 'i' for int
  * - 'f' for float
  * - 'c' for char
- * - 's' for string (char[STRING_LENGTH]) - `STRING_LENGTH` is defined as 50.
+ * - 's' for string (char*) - pointers into one string arena, strings of any length.
  *
  * @param arr       Pointer to the array to print.
  * @param size      Number of elements in the array.
  * @param type      Data type of the array elements:
- *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char[STRING_LENGTH]).
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
  * @return          void
  */
 void print_array(void *arr, int size, char type) {
@@ -295,7 +567,7 @@ void print_array(void *arr, int size, char type) {
                 printf("'%c'", ((char *)arr)[i]);
                 break;
             case 's':
-                printf("\"%s\"", ((char (*)[STRING_LENGTH])arr)[i]);
+                printf("\"%s\"", ((char**)arr)[i]);
                 break;
             default:
                 printf("Unknown type");
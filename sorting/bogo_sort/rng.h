@@ -0,0 +1,154 @@
+//
+// Created by Dany on 10/17/2026.
+// Copyright (c) 2026 DanyilT. All rights reserved.
+// MIT License: https://github.com/DanyilT/C/blob/main/LICENSE
+// This file is part of 'DanyilT/C' repo: https://github.com/DanyilT/C
+//
+// RNG: Seedable xoshiro256** and PCG32 Generators with Unbiased Bounded Ranges
+//
+
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+#include <string.h>
+
+// Generators a `rng_t` can run, picked by name with `rng_kind_from_name()`
+typedef enum { RNG_XOSHIRO, RNG_PCG, RNG_KIND_COUNT } rng_kind_t;
+static const char *rng_names[RNG_KIND_COUNT] = {"xoshiro", "pcg"};
+
+// Generator state, owned by one thread (there is no shared state like `rand()` has)
+typedef struct {
+    rng_kind_t kind;
+    uint64_t s[4]; // xoshiro256**: the 256-bit state; PCG32: s[0] is the state, s[1] the (odd) stream increment
+} rng_t;
+
+/**
+ * Maps a `--rng` name to its generator.
+ *
+ * @param name      "xoshiro" or "pcg".
+ * @return          The generator, -1 for an unknown name.
+ */
+static inline int rng_kind_from_name(const char *name) {
+    for (int kind = 0; kind < RNG_KIND_COUNT; kind++) if (strcmp(name, rng_names[kind]) == 0) return kind;
+    return -1;
+}
+
+/**
+ * SplitMix64 step: turns a counter into well-mixed 64-bit values, used to expand a seed into a state.
+ *
+ * @param x         Counter, advanced by the call.
+ * @return          Next mixed value.
+ */
+static inline uint64_t rng_splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t rng_rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+/**
+ * Advances a xoshiro256** state by 2^128 steps: streams started this many jumps apart never overlap.
+ *
+ * @param rng       xoshiro256** generator to advance.
+ * @return          void
+ */
+static inline void rng_jump(rng_t *rng) {
+    static const uint64_t jump[] = {0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL};
+    uint64_t s[4] = {0};
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (jump[i] & (1ULL << b)) for (int w = 0; w < 4; w++) s[w] ^= rng->s[w];
+            uint64_t t = rng->s[1] << 17; // One xoshiro256 step
+            rng->s[2] ^= rng->s[0];
+            rng->s[3] ^= rng->s[1];
+            rng->s[1] ^= rng->s[2];
+            rng->s[0] ^= rng->s[3];
+            rng->s[2] ^= t;
+            rng->s[3] = rng_rotl(rng->s[3], 45);
+        }
+    }
+    memcpy(rng->s, s, sizeof(s));
+}
+
+/**
+ * Returns 32 random bits: the high half of xoshiro256** (its best bits), or one PCG32 output.
+ *
+ * @param rng       Generator to advance.
+ * @return          Uniform 32-bit value.
+ */
+static inline uint32_t rng_next32(rng_t *rng) {
+    uint64_t *s = rng->s;
+    if (rng->kind == RNG_PCG) {
+        uint64_t old = s[0];
+        s[0] = old * 6364136223846793005ULL + s[1];
+        uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+        uint32_t rot = (uint32_t)(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+    }
+    uint64_t result = rng_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 45);
+    return (uint32_t)(result >> 32);
+}
+
+/**
+ * Seeds a generator. The same (kind, seed, stream) always gives the same sequence, and different
+ * streams of one seed are independent: xoshiro streams are `stream` jumps of 2^128 apart, PCG
+ * streams use different increments.
+ *
+ * @param rng       Generator to seed.
+ * @param kind      `RNG_XOSHIRO` or `RNG_PCG`.
+ * @param seed      Seed (`--seed`).
+ * @param stream    Stream number, e.g. the thread index.
+ * @return          void
+ */
+static inline void rng_seed(rng_t *rng, rng_kind_t kind, uint64_t seed, int stream) {
+    uint64_t x = seed;
+    rng->kind = kind;
+    if (kind == RNG_PCG) {
+        uint64_t initial = rng_splitmix64(&x);
+        memset(rng->s, 0, sizeof(rng->s));
+        rng->s[1] = (rng_splitmix64(&x) + (uint64_t)stream) << 1 | 1; // Odd increment per stream
+        rng_next32(rng); // pcg32_srandom(): step, add the initial state, step
+        rng->s[0] += initial;
+        rng_next32(rng);
+        return;
+    }
+    for (int w = 0; w < 4; w++) rng->s[w] = rng_splitmix64(&x); // SplitMix64 expansion, as the xoshiro authors recommend
+    for (int j = 0; j < stream; j++) rng_jump(rng);
+}
+
+/**
+ * Returns a uniform value in [0, range) with Lemire's multiply-shift method.
+ *
+ * `rand() % range` favours small values whenever `range` does not divide `RAND_MAX + 1`, and costs a
+ * division per call. Here the value is the high half of `x * range`; the few `x` that would make some
+ * results more likely are rejected, which needs a division only in the rare case the low half falls
+ * below `range`.
+ *
+ * @param rng       Generator to draw from.
+ * @param range     Number of possible results (at least 1).
+ * @return          Uniform value in [0, range).
+ */
+static inline uint32_t rng_bounded(rng_t *rng, uint32_t range) {
+    uint64_t m = (uint64_t)rng_next32(rng) * range;
+    uint32_t low = (uint32_t)m;
+    if (low < range) {
+        uint32_t threshold = -range % range; // 2^32 mod range
+        while (low < threshold) {
+            m = (uint64_t)rng_next32(rng) * range;
+            low = (uint32_t)m;
+        }
+    }
+    return (uint32_t)(m >> 32);
+}
+
+#endif //RNG_H
@@ -10,22 +10,46 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 #include "ansi_colors.h" // Include ANSI color codes for console output (custom header file)
+#include "array_file.h" // Binary and line-delimited array files for `--in` / `--out` (custom header file)
+#include "text_reader.h" // Buffered `read()` input with a SWAR number parser for the prompts (custom header file)
+#include "sorting_network.h" // Sorting networks for int and float arrays of up to 16 elements (custom header file)
 
-#define STRING_LENGTH 50
+// Work counters, updated by the sorts and printed after sorting
+size_t pass_count = 0;
+size_t comparison_count = 0;
+int cocktail = 0; // Bidirectional passes (`--cocktail`)
 
 void bubble_sort(void *arr, int size, char type, int visualize);
+void cocktail_sort(void *arr, int size, char type, int visualize);
+int compare_and_swap(void *arr, int j, char type, int visualize, int size);
+void sort_file_array(void *arr, int size, char type);
+void report_counts(FILE *out, int size);
 void print_array(void *arr, int size, char type);
+char **read_strings(int size, char **arena);
 void print_array_with_highlight(void *arr, int size, char type, int index[2]);
 
 int main(int argc, char *argv[]) {
     int visualize = 0;
-    if (argc > 1) if (strcmp(argv[1], "-v") == 0 || strcmp(argv[1], "--visualize") == 0) visualize = 1; // Enable visualization if -v or --visualize is passed
+    const char *input_path = NULL, *output_path = NULL, *format = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0 || strcmp(argv[i], "--visualize") == 0) visualize = 1; // Enable visualization if -v or --visualize is passed
+        else if (strcmp(argv[i], "--cocktail") == 0) cocktail = 1; // Bidirectional passes (cocktail shaker sort)
+        else if (strcmp(argv[i], "--in") == 0 && i + 1 < argc) input_path = argv[++i]; // Sort an array file instead of prompting (needs --format)
+        else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) output_path = argv[++i]; // Output file of --in (default: stdout)
+        else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) format = argv[++i]; // Array file format: i32, f32, u8 or lines
+    }
+
+    array_file_report = report_counts;
+    if (input_path) return sort_array_file(input_path, output_path, format, sort_file_array);
 
+    setvbuf(stdin, NULL, _IONBF, 0); // The number prompts read stdin with `read()` (text_reader.h), so stdio must not read ahead
     int choice;
     printf(MAGENTA "Bubble Sort\n");
     printf("===========\n" RESET);
     if (visualize) printf(BG_YELLOW "Visualization enabled." RESET "\n");
+    if (cocktail) printf(BG_YELLOW "Cocktail shaker mode enabled." RESET "\n");
     printf("Choose data type:\n");
     printf("1. Integers\n");
     printf("2. Floats\n");
@@ -40,6 +64,7 @@ int main(int argc, char *argv[]) {
 
     char type = 0;
     void *arr = NULL;
+    char *arena = NULL; // Backing storage of the strings when sorting 's' (`arr` then holds pointers into it)
 
     switch(choice) {
         // For integers
@@ -47,9 +72,12 @@ int main(int argc, char *argv[]) {
             type = 'i';
             arr = malloc(size * sizeof(int));
 
+            text_reader_t reader;
+            text_reader_open(&reader, STDIN_FILENO);
             printf("Enter %d integers: ", size);
-            for (int i = 0; i < size; i++) scanf("%*[^0-9]%d", &((int*)arr)[i]);
-            while (getchar() != '\n'); // Clear input buffer
+            for (int i = 0; i < size; i++) text_reader_int(&reader, &((int*)arr)[i]);
+            text_reader_skip_line(&reader); // Clear input buffer
+            text_reader_close(&reader);
             break;
         }
         // For floats
@@ -57,9 +85,12 @@ int main(int argc, char *argv[]) {
             type = 'f';
             arr = malloc(size * sizeof(float));
 
+            text_reader_t reader;
+            text_reader_open(&reader, STDIN_FILENO);
             printf("Enter %d floats: ", size);
-            for (int i = 0; i < size; i++) scanf("%*[^0-9.]%f", &((float*)arr)[i]);
-            while (getchar() != '\n'); // Clear input buffer
+            for (int i = 0; i < size; i++) text_reader_float(&reader, &((float*)arr)[i]);
+            text_reader_skip_line(&reader); // Clear input buffer
+            text_reader_close(&reader);
             break;
         }
         // For characters
@@ -75,10 +106,9 @@ int main(int argc, char *argv[]) {
         // For strings
         case 4: {
             type = 's';
-            arr = malloc(size * STRING_LENGTH * sizeof(char));
 
             printf("Enter %d strings: ", size);
-            for (int i = 0; i < size; i++) scanf("%s", ((char(*)[STRING_LENGTH])arr)[i]);
+            arr = read_strings(size, &arena);
             while (getchar() != '\n'); // Clear input buffer
             break;
         }
@@ -95,99 +125,264 @@ int main(int argc, char *argv[]) {
     printf(RESET);
 
     printf(DIM "Sorting...\n" RESET);
-    bubble_sort(arr, size, type, visualize);
+    if (cocktail) cocktail_sort(arr, size, type, visualize);
+    else bubble_sort(arr, size, type, visualize);
 
     printf(GREEN "\n-- Sorted Array\n" RESET BOLD);
     print_array(arr, size, type);
     printf(RESET);
+    if (size > 1 && pass_count == 0) printf(DIM "Sorted by a %d-input sorting network (use -v to see the passes)\n" RESET, size);
+    else printf(DIM "Passes: %zu, comparisons: %zu (worst case: %d passes, %lld comparisons)\n" RESET,
+                pass_count, comparison_count, size > 1 ? size - 1 : 0, (long long)size * (size - 1) / 2);
 
     free(arr);
+    free(arena);
     return 0;
 }
 
 /**
  * Performs bubble sort on an array of various types.
  *
+ * Every pass stops at the last swap of the previous pass: the elements after it are already in
+ * their final place. A pass without swaps leaves the boundary at 0 and ends the sort, so an
+ * already sorted array takes one pass (n - 1 comparisons).
+ *
  * Supported types:
  * - 'i' for int
  * - 'f' for float
  * - 'c' for char
- * - 's' for string (char[STRING_LENGTH]) - `STRING_LENGTH` is defined as 50.
+ * - 's' for string (char*) - pointers into one string arena, strings of any length.
  *
  * @param arr       Pointer to the array to sort.
  * @param size      Number of elements in the array.
  * @param type      Data type of the array elements:
- *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char[STRING_LENGTH]).
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
  * @param visualize Flag to enable step-by-step visualization. (1 = enable, 0 = disable)
  * @return          void
  */
 void bubble_sort(void *arr, int size, char type, int visualize) {
+    // Tiny int and float arrays: the network's comparators cost less than the passes and their type checks
+    if (!visualize && sort_network(arr, size, type)) return;
     if (visualize) printf(BOLD "\nStep-by-step sorting:\n" RESET);
 
-    for (int i = 0; i < size - 1; i++) {
-        if (visualize) printf(CYAN "Pass %d:\n" RESET, i + 1);
+    int boundary = size - 1; // Pairs (j, j + 1) with j < boundary may still be out of order
+    while (boundary > 0) {
+        pass_count++;
+        if (visualize) printf(CYAN "Pass %zu (indices 0-%d):\n" RESET, pass_count, boundary);
 
-        int swapped = 0;
-        for (int j = 0; j < size - i - 1; j++) {
-            if (visualize) {
-                printf("  Comparing indices %d and %d -> ", j, j + 1);
-                print_array_with_highlight(arr, size, type, (int []) {j, j + 1});
-            }
+        int last_swap = 0;
+        for (int j = 0; j < boundary; j++) {
+            int swapped = compare_and_swap(arr, j, type, visualize, size);
+            if (swapped < 0) return; // Unknown type
+            if (swapped) last_swap = j;
+        }
 
-            switch (type) {
-                case 'i': // Integer
-                case 'f': // Float
-                    if (((float*)arr)[j] > ((float*)arr)[j + 1]) {
-                        swapped = 1;
-                        // Swap elements
-                        float temp = ((float*)arr)[j];
-                        ((float*)arr)[j] = ((float*)arr)[j + 1];
-                        ((float*)arr)[j + 1] = temp;
-                    }
-                    break;
-                case 'c': // Character
-                    if (((char*)arr)[j] > ((char*)arr)[j + 1]) {
-                        swapped = 1;
-                        // Swap elements
-                        char temp = ((char*)arr)[j];
-                        ((char*)arr)[j] = ((char*)arr)[j + 1];
-                        ((char*)arr)[j + 1] = temp;
-                    }
-                    break;
-                case 's': // String
-                    if (strcmp(((char(*)[STRING_LENGTH])arr)[j], ((char(*)[STRING_LENGTH])arr)[j + 1]) > 0) {
-                        swapped = 1;
-                        // Swap elements
-                        char temp[STRING_LENGTH];
-                        strcpy(temp, ((char(*)[STRING_LENGTH])arr)[j]);
-                        strcpy(((char(*)[STRING_LENGTH])arr)[j], ((char(*)[STRING_LENGTH])arr)[j + 1]);
-                        strcpy(((char(*)[STRING_LENGTH])arr)[j + 1], temp);
-                    }
-                    break;
-                default:
-                    return; // Unknown type
-            }
+        if (visualize) {
+            printf("  End of pass %zu: ", pass_count);
+            print_array(arr, size, type);
+            printf("\n");
+        }
 
-            if (swapped && visualize) {
-                printf(GREEN "    ✓ Swapped -> " RESET);
-                print_array_with_highlight(arr, size, type, (int []) {j, j + 1});
-            } else if (!swapped && visualize) {
-                printf(RED "    ✗ No swap needed\n" RESET);
-            }
+        // Everything from the last swap on is in place; no swap at all means the array is sorted
+        boundary = last_swap;
+        if (boundary == 0 && visualize) printf(GREEN "Array is sorted! Early termination.\n" RESET);
+    }
+}
+
+/**
+ * Sorts an array loaded by `--in` with the options from the command line (never visualized).
+ *
+ * @param arr       Pointer to the array to sort.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @return          void
+ */
+void sort_file_array(void *arr, int size, char type) {
+    if (cocktail) cocktail_sort(arr, size, type, 0);
+    else bubble_sort(arr, size, type, 0);
+}
+
+/**
+ * Appends the pass and comparison counts of the last sort to the `--in` timing line.
+ *
+ * @param out       Stream of the timing line.
+ * @param size      Number of elements sorted.
+ * @return          void
+ */
+void report_counts(FILE *out, int size) {
+    if (size > 1 && pass_count == 0) fprintf(out, ", %d-input sorting network", size);
+    else fprintf(out, ", %zu passes, %zu comparisons", pass_count, comparison_count);
+}
+
+/**
+ * Performs cocktail shaker sort (bidirectional bubble sort) on an array of various types.
+ *
+ * Forward passes carry the largest element up, backward passes carry the smallest element down.
+ * Both ends shrink to the last swap of their pass, and the sort ends when they meet. Small elements
+ * near the end (the "turtles" that plain bubble sort moves one step per pass) need a single backward pass.
+ *
+ * Supported types:
+ * - 'i' for int
+ * - 'f' for float
+ * - 'c' for char
+ * - 's' for string (char*) - pointers into one string arena, strings of any length.
+ *
+ * @param arr       Pointer to the array to sort.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @param visualize Flag to enable step-by-step visualization. (1 = enable, 0 = disable)
+ * @return          void
+ */
+void cocktail_sort(void *arr, int size, char type, int visualize) {
+    if (!visualize && sort_network(arr, size, type)) return; // Tiny int and float arrays, see `bubble_sort()`
+    if (visualize) printf(BOLD "\nStep-by-step sorting:\n" RESET);
+
+    int low = 0, high = size - 1; // Only arr[low..high] may still be out of order
+    while (low < high) {
+        // Forward pass: the largest element moves to `high`
+        pass_count++;
+        if (visualize) printf(CYAN "Pass %zu, forward (indices %d-%d):\n" RESET, pass_count, low, high);
+        int last_swap = low;
+        for (int j = low; j < high; j++) {
+            int swapped = compare_and_swap(arr, j, type, visualize, size);
+            if (swapped < 0) return; // Unknown type
+            if (swapped) last_swap = j;
         }
+        high = last_swap;
+        if (low >= high) break;
+
+        // Backward pass: the smallest element moves to `low`
+        pass_count++;
+        if (visualize) printf(CYAN "Pass %zu, backward (indices %d-%d):\n" RESET, pass_count, low, high);
+        last_swap = high;
+        for (int j = high - 1; j >= low; j--) {
+            if (compare_and_swap(arr, j, type, visualize, size)) last_swap = j + 1;
+        }
+        low = last_swap;
 
         if (visualize) {
-            printf("  End of pass %d: ", i + 1);
+            printf("  End of pass %zu: ", pass_count);
             print_array(arr, size, type);
             printf("\n");
         }
+    }
+
+    if (visualize) printf(GREEN "Array is sorted! Early termination.\n" RESET);
+}
+
+/**
+ * Compares the neighbours `arr[j]` and `arr[j + 1]` and swaps them if they are out of order.
+ *
+ * Supported types:
+ * - 'i' for int
+ * - 'f' for float
+ * - 'c' for char
+ * - 's' for string (char*) - pointers into one string arena, strings of any length.
+ *
+ * @param arr       Pointer to the array.
+ * @param j         Index of the left element of the pair.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @param visualize Flag to print the comparison and its outcome. (1 = enable, 0 = disable)
+ * @param size      Number of elements in the array (for printing).
+ * @return          1 if the elements were swapped, 0 if not, -1 for an unknown type.
+ */
+int compare_and_swap(void *arr, int j, char type, int visualize, int size) {
+    comparison_count++;
+    if (visualize) {
+        printf("  Comparing indices %d and %d -> ", j, j + 1);
+        print_array_with_highlight(arr, size, type, (int []) {j, j + 1});
+    }
 
-        // If no swapping occurred, array is sorted
-        if (!swapped) {
-            if (visualize) printf(GREEN "Array is sorted! Early termination.\n" RESET);
+    int swapped = 0;
+    switch (type) {
+        case 'i': // Integer
+            if (((int*)arr)[j] > ((int*)arr)[j + 1]) {
+                swapped = 1;
+                // Swap elements
+                int temp = ((int*)arr)[j];
+                ((int*)arr)[j] = ((int*)arr)[j + 1];
+                ((int*)arr)[j + 1] = temp;
+            }
+            break;
+        case 'f': // Float
+            if (((float*)arr)[j] > ((float*)arr)[j + 1]) {
+                swapped = 1;
+                // Swap elements
+                float temp = ((float*)arr)[j];
+                ((float*)arr)[j] = ((float*)arr)[j + 1];
+                ((float*)arr)[j + 1] = temp;
+            }
             break;
+        case 'c': // Character
+            if (((char*)arr)[j] > ((char*)arr)[j + 1]) {
+                swapped = 1;
+                // Swap elements
+                char temp = ((char*)arr)[j];
+                ((char*)arr)[j] = ((char*)arr)[j + 1];
+                ((char*)arr)[j + 1] = temp;
+            }
+            break;
+        case 's': // String
+            if (strcmp(((char**)arr)[j], ((char**)arr)[j + 1]) > 0) {
+                swapped = 1;
+                // Swap elements
+                char *temp = ((char**)arr)[j]; // Swap pointers, the strings stay in the arena
+                ((char**)arr)[j] = ((char**)arr)[j + 1];
+                ((char**)arr)[j + 1] = temp;
+            }
+            break;
+        default:
+            return -1; // Unknown type
+    }
+
+    if (swapped && visualize) {
+        printf(GREEN "    ✓ Swapped -> " RESET);
+        print_array_with_highlight(arr, size, type, (int []) {j, j + 1});
+    } else if (!swapped && visualize) {
+        printf(RED "    ✗ No swap needed\n" RESET);
+    }
+    return swapped;
+}
+
+/**
+ * Reads whitespace-separated strings of any length from standard input into one arena.
+ *
+ * All characters are appended back to back (each string NUL-terminated) to a single growing buffer,
+ * and the returned array holds one pointer per string into it. Sorting then only moves pointers.
+ * The character that ends the last string is pushed back, so the caller can still clear the line.
+ *
+ * @param size      Number of strings to read.
+ * @param arena     Receives the arena holding the characters. Free it after the pointer array.
+ * @return          Array of `size` pointers into the arena.
+ */
+char **read_strings(int size, char **arena) {
+    size_t capacity = 256, used = 0;
+    size_t *offsets = malloc(size * sizeof(size_t)); // Offsets, because the arena may move while growing
+    *arena = malloc(capacity);
+
+    int c = EOF;
+    for (int i = 0; i < size; i++) {
+        c = getchar();
+        while (c != EOF && isspace(c)) c = getchar();
+
+        offsets[i] = used;
+        while (1) {
+            if (used + 1 >= capacity) *arena = realloc(*arena, capacity *= 2);
+            if (c == EOF || isspace(c)) break;
+            (*arena)[used++] = (char)c;
+            c = getchar();
         }
+        (*arena)[used++] = '\0';
     }
+    if (c != EOF) ungetc(c, stdin);
+
+    char **strings = malloc(size * sizeof(char*));
+    for (int i = 0; i < size; i++) strings[i] = *arena + offsets[i];
+    free(offsets);
+    return strings;
 }
 
 /**
@@ -197,12 +392,12 @@ void bubble_sort(void *arr, int size, char type, int visualize) {
  * - 'i' for int
  * - 'f' for float
  * - 'c' for char
- * - 's' for string (char[STRING_LENGTH]) - `STRING_LENGTH` is defined as 50.
+ * - 's' for string (char*) - pointers into one string arena, strings of any length.
  *
  * @param arr       Pointer to the array to print.
  * @param size      Number of elements in the array.
  * @param type      Data type of the array elements:
- *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char[STRING_LENGTH]).
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
  * @return          void
  */
 void print_array(void *arr, int size, char type) {
@@ -216,12 +411,12 @@ void print_array(void *arr, int size, char type) {
  * - 'i' for int
  * - 'f' for float
  * - 'c' for char
- * - 's' for string (char[STRING_LENGTH]) - `STRING_LENGTH` is defined as 50.
+ * - 's' for string (char*) - pointers into one string arena, strings of any length.
  *
  * @param arr       Pointer to the array to print.
  * @param size      Number of elements in the array.
  * @param type      Data type of the array elements:
- *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char[STRING_LENGTH]).
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
  * @param index     First and second index to highlight (-1 for no highlight).
  * @return          void
  */
@@ -241,7 +436,7 @@ void print_array_with_highlight(void *arr, int size, char type, int index[2]) {
                 printf("'%c'", ((char *)arr)[i]);
                 break;
             case 's':
-                printf("\"%s\"", ((char (*)[STRING_LENGTH])arr)[i]);
+                printf("\"%s\"", ((char**)arr)[i]);
                 break;
             default:
                 printf("Unknown type");
@@ -0,0 +1,244 @@
+//
+// Created by Dany on 10/17/2026.
+// Copyright (c) 2026 DanyilT. All rights reserved.
+// MIT License: https://github.com/DanyilT/C/blob/main/LICENSE
+// This file is part of 'DanyilT/C' repo: https://github.com/DanyilT/C
+//
+// Sorting Networks for Tiny Int and Float Arrays
+//
+
+#ifndef SORTING_NETWORK_H
+#define SORTING_NETWORK_H
+
+#ifdef __SSE__
+#include <xmmintrin.h> // minss / maxss for the float compare-exchange
+#endif
+
+#define SORT_NETWORK_MAX 16 // Arrays of up to this many ints or floats are sorted by a sorting network
+
+// Comparator lists of the networks, one layer of independent comparators per line. Each macro expands `CE(i, j)` for every
+// comparator, so the sorter below becomes straight-line code at compile time. 2-12 and 16 inputs use the smallest networks
+// known; 13-15 are Green's 16-input network with the top wires cut off (13 inputs: 46 comparators, the best known is 45).
+
+// 2 inputs: 1 comparator, depth 1
+#define SORT_NETWORK_2(CE)                                                                                                      \
+    CE(0, 1)
+
+// 3 inputs: 3 comparators, depth 3
+#define SORT_NETWORK_3(CE)                                                                                                      \
+    CE(0, 2)                                                                                                                    \
+    CE(0, 1)                                                                                                                    \
+    CE(1, 2)
+
+// 4 inputs: 5 comparators, depth 3
+#define SORT_NETWORK_4(CE)                                                                                                      \
+    CE(0, 2) CE(1, 3)                                                                                                           \
+    CE(0, 1) CE(2, 3)                                                                                                           \
+    CE(1, 2)
+
+// 5 inputs: 9 comparators, depth 5
+#define SORT_NETWORK_5(CE)                                                                                                      \
+    CE(0, 3) CE(1, 4)                                                                                                           \
+    CE(0, 2) CE(1, 3)                                                                                                           \
+    CE(0, 1) CE(2, 4)                                                                                                           \
+    CE(1, 2) CE(3, 4)                                                                                                           \
+    CE(2, 3)
+
+// 6 inputs: 12 comparators, depth 5
+#define SORT_NETWORK_6(CE)                                                                                                      \
+    CE(0, 5) CE(1, 3) CE(2, 4)                                                                                                  \
+    CE(1, 2) CE(3, 4)                                                                                                           \
+    CE(0, 3) CE(2, 5)                                                                                                           \
+    CE(0, 1) CE(2, 3) CE(4, 5)                                                                                                  \
+    CE(1, 2) CE(3, 4)
+
+// 7 inputs: 16 comparators, depth 6
+#define SORT_NETWORK_7(CE)                                                                                                      \
+    CE(0, 6) CE(2, 3) CE(4, 5)                                                                                                  \
+    CE(0, 2) CE(1, 4) CE(3, 6)                                                                                                  \
+    CE(0, 1) CE(2, 5) CE(3, 4)                                                                                                  \
+    CE(1, 2) CE(4, 6)                                                                                                           \
+    CE(2, 3) CE(4, 5)                                                                                                           \
+    CE(1, 2) CE(3, 4) CE(5, 6)
+
+// 8 inputs: 19 comparators, depth 6
+#define SORT_NETWORK_8(CE)                                                                                                      \
+    CE(0, 2) CE(1, 3) CE(4, 6) CE(5, 7)                                                                                         \
+    CE(0, 4) CE(1, 5) CE(2, 6) CE(3, 7)                                                                                         \
+    CE(0, 1) CE(2, 3) CE(4, 5) CE(6, 7)                                                                                         \
+    CE(2, 4) CE(3, 5)                                                                                                           \
+    CE(1, 4) CE(3, 6)                                                                                                           \
+    CE(1, 2) CE(3, 4) CE(5, 6)
+
+// 9 inputs: 25 comparators, depth 7
+#define SORT_NETWORK_9(CE)                                                                                                      \
+    CE(0, 3) CE(1, 7) CE(2, 5) CE(4, 8)                                                                                         \
+    CE(0, 7) CE(2, 4) CE(3, 8) CE(5, 6)                                                                                         \
+    CE(0, 2) CE(1, 3) CE(4, 5) CE(7, 8)                                                                                         \
+    CE(1, 4) CE(3, 6) CE(5, 7)                                                                                                  \
+    CE(0, 1) CE(2, 4) CE(3, 5) CE(6, 8)                                                                                         \
+    CE(2, 3) CE(4, 5) CE(6, 7)                                                                                                  \
+    CE(1, 2) CE(3, 4) CE(5, 6)
+
+// 10 inputs: 29 comparators, depth 8
+#define SORT_NETWORK_10(CE)                                                                                                     \
+    CE(0, 8) CE(1, 9) CE(2, 7) CE(3, 5) CE(4, 6)                                                                                \
+    CE(0, 2) CE(1, 4) CE(5, 8) CE(7, 9)                                                                                         \
+    CE(0, 3) CE(2, 4) CE(5, 7) CE(6, 9)                                                                                         \
+    CE(0, 1) CE(3, 6) CE(8, 9)                                                                                                  \
+    CE(1, 5) CE(2, 3) CE(4, 8) CE(6, 7)                                                                                         \
+    CE(1, 2) CE(3, 5) CE(4, 6) CE(7, 8)                                                                                         \
+    CE(2, 3) CE(4, 5) CE(6, 7)                                                                                                  \
+    CE(3, 4) CE(5, 6)
+
+// 11 inputs: 35 comparators, depth 8
+#define SORT_NETWORK_11(CE)                                                                                                     \
+    CE(0, 9) CE(1, 6) CE(2, 4) CE(3, 7) CE(5, 8)                                                                                \
+    CE(0, 1) CE(3, 5) CE(4, 10) CE(6, 9) CE(7, 8)                                                                               \
+    CE(1, 3) CE(2, 5) CE(4, 7) CE(8, 10)                                                                                        \
+    CE(0, 4) CE(1, 2) CE(3, 7) CE(5, 9) CE(6, 8)                                                                                \
+    CE(0, 1) CE(2, 6) CE(4, 5) CE(7, 8) CE(9, 10)                                                                               \
+    CE(2, 4) CE(3, 6) CE(5, 7) CE(8, 9)                                                                                         \
+    CE(1, 2) CE(3, 4) CE(5, 6) CE(7, 8)                                                                                         \
+    CE(2, 3) CE(4, 5) CE(6, 7)
+
+// 12 inputs: 39 comparators, depth 9
+#define SORT_NETWORK_12(CE)                                                                                                     \
+    CE(0, 8) CE(1, 7) CE(2, 6) CE(3, 11) CE(4, 10) CE(5, 9)                                                                     \
+    CE(0, 1) CE(2, 5) CE(3, 4) CE(6, 9) CE(7, 8) CE(10, 11)                                                                     \
+    CE(0, 2) CE(1, 6) CE(5, 10) CE(9, 11)                                                                                       \
+    CE(0, 3) CE(1, 2) CE(4, 6) CE(5, 7) CE(8, 11) CE(9, 10)                                                                     \
+    CE(1, 4) CE(3, 5) CE(6, 8) CE(7, 10)                                                                                        \
+    CE(1, 3) CE(2, 5) CE(6, 9) CE(8, 10)                                                                                        \
+    CE(2, 3) CE(4, 5) CE(6, 7) CE(8, 9)                                                                                         \
+    CE(4, 6) CE(5, 7)                                                                                                           \
+    CE(3, 4) CE(5, 6) CE(7, 8)
+
+// 13 inputs: 46 comparators, depth 10
+#define SORT_NETWORK_13(CE)                                                                                                     \
+    CE(1, 12) CE(4, 8) CE(5, 6) CE(7, 11) CE(9, 10)                                                                             \
+    CE(0, 5) CE(1, 7) CE(2, 9) CE(3, 4) CE(11, 12)                                                                              \
+    CE(0, 1) CE(2, 3) CE(4, 5) CE(6, 8) CE(7, 9) CE(10, 11)                                                                     \
+    CE(0, 2) CE(1, 3) CE(4, 10) CE(5, 11) CE(6, 7) CE(8, 9)                                                                     \
+    CE(1, 2) CE(3, 12) CE(4, 6) CE(5, 7) CE(8, 10) CE(9, 11)                                                                    \
+    CE(1, 4) CE(2, 6) CE(5, 8) CE(7, 10)                                                                                        \
+    CE(2, 4) CE(3, 6) CE(9, 12)                                                                                                 \
+    CE(3, 5) CE(6, 8) CE(7, 9) CE(10, 12)                                                                                       \
+    CE(3, 4) CE(5, 6) CE(7, 8) CE(9, 10) CE(11, 12)                                                                             \
+    CE(6, 7) CE(8, 9)
+
+// 14 inputs: 51 comparators, depth 10
+#define SORT_NETWORK_14(CE)                                                                                                     \
+    CE(0, 13) CE(1, 12) CE(4, 8) CE(5, 6) CE(7, 11) CE(9, 10)                                                                   \
+    CE(0, 5) CE(1, 7) CE(2, 9) CE(3, 4) CE(6, 13) CE(11, 12)                                                                    \
+    CE(0, 1) CE(2, 3) CE(4, 5) CE(6, 8) CE(7, 9) CE(10, 11) CE(12, 13)                                                          \
+    CE(0, 2) CE(1, 3) CE(4, 10) CE(5, 11) CE(6, 7) CE(8, 9)                                                                     \
+    CE(1, 2) CE(3, 12) CE(4, 6) CE(5, 7) CE(8, 10) CE(9, 11)                                                                    \
+    CE(1, 4) CE(2, 6) CE(5, 8) CE(7, 10) CE(9, 13)                                                                              \
+    CE(2, 4) CE(3, 6) CE(9, 12) CE(11, 13)                                                                                      \
+    CE(3, 5) CE(6, 8) CE(7, 9) CE(10, 12)                                                                                       \
+    CE(3, 4) CE(5, 6) CE(7, 8) CE(9, 10) CE(11, 12)                                                                             \
+    CE(6, 7) CE(8, 9)
+
+// 15 inputs: 56 comparators, depth 10
+#define SORT_NETWORK_15(CE)                                                                                                     \
+    CE(0, 13) CE(1, 12) CE(3, 14) CE(4, 8) CE(5, 6) CE(7, 11) CE(9, 10)                                                         \
+    CE(0, 5) CE(1, 7) CE(2, 9) CE(3, 4) CE(6, 13) CE(8, 14) CE(11, 12)                                                          \
+    CE(0, 1) CE(2, 3) CE(4, 5) CE(6, 8) CE(7, 9) CE(10, 11) CE(12, 13)                                                          \
+    CE(0, 2) CE(1, 3) CE(4, 10) CE(5, 11) CE(6, 7) CE(8, 9) CE(12, 14)                                                          \
+    CE(1, 2) CE(3, 12) CE(4, 6) CE(5, 7) CE(8, 10) CE(9, 11) CE(13, 14)                                                         \
+    CE(1, 4) CE(2, 6) CE(5, 8) CE(7, 10) CE(9, 13) CE(11, 14)                                                                   \
+    CE(2, 4) CE(3, 6) CE(9, 12) CE(11, 13)                                                                                      \
+    CE(3, 5) CE(6, 8) CE(7, 9) CE(10, 12)                                                                                       \
+    CE(3, 4) CE(5, 6) CE(7, 8) CE(9, 10) CE(11, 12)                                                                             \
+    CE(6, 7) CE(8, 9)
+
+// 16 inputs: 60 comparators, depth 10
+#define SORT_NETWORK_16(CE)                                                                                                     \
+    CE(0, 13) CE(1, 12) CE(2, 15) CE(3, 14) CE(4, 8) CE(5, 6) CE(7, 11) CE(9, 10)                                               \
+    CE(0, 5) CE(1, 7) CE(2, 9) CE(3, 4) CE(6, 13) CE(8, 14) CE(10, 15) CE(11, 12)                                               \
+    CE(0, 1) CE(2, 3) CE(4, 5) CE(6, 8) CE(7, 9) CE(10, 11) CE(12, 13) CE(14, 15)                                               \
+    CE(0, 2) CE(1, 3) CE(4, 10) CE(5, 11) CE(6, 7) CE(8, 9) CE(12, 14) CE(13, 15)                                               \
+    CE(1, 2) CE(3, 12) CE(4, 6) CE(5, 7) CE(8, 10) CE(9, 11) CE(13, 14)                                                         \
+    CE(1, 4) CE(2, 6) CE(5, 8) CE(7, 10) CE(9, 13) CE(11, 14)                                                                   \
+    CE(2, 4) CE(3, 6) CE(9, 12) CE(11, 13)                                                                                      \
+    CE(3, 5) CE(6, 8) CE(7, 9) CE(10, 12)                                                                                       \
+    CE(3, 4) CE(5, 6) CE(7, 8) CE(9, 10) CE(11, 12)                                                                             \
+    CE(6, 7) CE(8, 9)
+// Compare-exchange of `a[i]` and `a[j]`: one swap flag drives both selects, so they can never disagree. (Separate min and
+// max tests do with a NaN: both come out false and one element is copied into both slots.) A NaN leaves the pair as it is
+#define SORT_NETWORK_CE(i, j) {                                                                                                 \
+    sort_network_elem_t x_ = a[i], y_ = a[j];                                                                                   \
+    int s_ = y_ < x_;                                                                                                           \
+    a[i] = s_ ? y_ : x_;                                                                                                        \
+    a[j] = s_ ? x_ : y_;                                                                                                        \
+}
+
+#ifdef __SSE__
+// The same compare-exchange for floats with minss / maxss: gcc turns the flag version above into a branch for floats.
+// minss(y, x) gives y < x ? y : x and maxss(x, y) gives x > y ? x : y, both the second operand with a NaN, so the
+// unordered pair stays in place exactly as above
+#define SORT_NETWORK_CE_FLOAT(i, j) {                                                                                           \
+    __m128 x_ = _mm_set_ss(a[i]), y_ = _mm_set_ss(a[j]);                                                                        \
+    sort_network_elem_t low_ = _mm_cvtss_f32(_mm_min_ss(y_, x_)), high_ = _mm_cvtss_f32(_mm_max_ss(x_, y_));                    \
+    a[i] = low_;                                                                                                                \
+    a[j] = high_;                                                                                                               \
+}
+#else
+#define SORT_NETWORK_CE_FLOAT SORT_NETWORK_CE
+#endif
+
+/**
+ * Defines a sorter `name(a, n)` that picks the network for `n` elements with one switch.
+ *
+ * @param name      Name of the generated function.
+ * @param T         Element type.
+ * @param CE        Compare-exchange macro `CE(i, j)` of the networks: `SORT_NETWORK_CE`, or
+ *                      `SORT_NETWORK_CE_FLOAT` for floats.
+ * @return          void (the generated function sorts `a[0..n)` in place)
+ */
+#define DEFINE_SORT_NETWORK(name, T, CE)                                                                                        \
+static inline void name(T *a, int n) {                                                                                          \
+    typedef T sort_network_elem_t;                                                                                              \
+    switch (n) {                                                                                                                \
+        case 2: SORT_NETWORK_2(CE) break;                                                                                       \
+        case 3: SORT_NETWORK_3(CE) break;                                                                                       \
+        case 4: SORT_NETWORK_4(CE) break;                                                                                       \
+        case 5: SORT_NETWORK_5(CE) break;                                                                                       \
+        case 6: SORT_NETWORK_6(CE) break;                                                                                       \
+        case 7: SORT_NETWORK_7(CE) break;                                                                                       \
+        case 8: SORT_NETWORK_8(CE) break;                                                                                       \
+        case 9: SORT_NETWORK_9(CE) break;                                                                                       \
+        case 10: SORT_NETWORK_10(CE) break;                                                                                     \
+        case 11: SORT_NETWORK_11(CE) break;                                                                                     \
+        case 12: SORT_NETWORK_12(CE) break;                                                                                     \
+        case 13: SORT_NETWORK_13(CE) break;                                                                                     \
+        case 14: SORT_NETWORK_14(CE) break;                                                                                     \
+        case 15: SORT_NETWORK_15(CE) break;                                                                                     \
+        case 16: SORT_NETWORK_16(CE) break;                                                                                     \
+        default: break; /* 0 or 1 elements are sorted already */                                                                \
+    }                                                                                                                           \
+}
+
+DEFINE_SORT_NETWORK(sort_network_int, int, SORT_NETWORK_CE)
+DEFINE_SORT_NETWORK(sort_network_float, float, SORT_NETWORK_CE_FLOAT)
+
+/**
+ * Sorts a tiny int or float array with a sorting network.
+ *
+ * @param arr       Pointer to the array to sort.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string.
+ * @return          1 if the array was sorted, 0 if it is too large or of another type and the caller has to sort it.
+ */
+static inline int sort_network(void *arr, int size, char type) {
+    if (size > SORT_NETWORK_MAX) return 0;
+    switch (type) {
+        case 'i': sort_network_int((int*)arr, size); return 1;
+        case 'f': sort_network_float((float*)arr, size); return 1;
+        default: return 0;
+    }
+}
+
+#endif // SORTING_NETWORK_H
@@ -10,22 +10,231 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
 #include "ansi_colors.h" // Include ANSI color codes for console output (custom header file)
+#include "array_file.h" // Binary and line-delimited array files for `--in` / `--out` (custom header file)
+#include "text_reader.h" // Buffered `read()` input with a SWAR number parser for the prompts (custom header file)
+#include "sorting_network.h" // Sorting networks for int and float arrays of up to 16 elements (custom header file)
 
-#define STRING_LENGTH 50
+#define STRING_LENGTH 50 // Row width of the fixed-size string layout used by `merge_sort_generic()`
+#define DEFAULT_RUN_LENGTH 24 // Runs of this many elements are insertion-sorted before bottom-up merging
+#define PARALLEL_CUTOFF 65536 // Subarrays smaller than this are sorted/merged on the current thread
+#define MAX_THREADS 256 // Upper bound of `--threads N`
+#define DEFAULT_MEMORY_MB 256 // Memory budget of the external sort (`--mem MB`)
+#define IO_BUFFER_SIZE (1 << 20) // stdio buffer size for the external sort's output file
+#define MERGE_BLOCK_MIN 1024 // Smallest block buffer of a run in the external merge, in integers
+#define MERGE_FAN_IN_MAX 64 // Most runs the external merge reads at once (each is an open temporary file)
+#define BATCH_GRAB 64 // Arrays a batch worker takes from the shared counter at a time
+#define BATCH_BENCHMARK_MAX_LENGTH 64 // `--batch-benchmark` arrays have 1 to this many elements
+#define RECORD_BENCHMARK_PAYLOAD 64 // Payload bytes after the int key of a `--record-benchmark` record
+#define RECORD_BENCHMARK_KEYS 1000 // `--record-benchmark` keys are drawn from this many values, so most keys repeat
+
+// String element: pointer to a NUL-terminated string of any length in the string arena (sorting moves only pointers)
+typedef char *string_t;
+
+// Heap allocation counters, updated by `counted_malloc()` for every temporary buffer the sort kernels request
+size_t allocation_count = 0;
+size_t allocation_bytes = 0;
+
+// Sort strategies selectable from the command line and compared by `--benchmark`
+typedef enum { MODE_GENERIC, MODE_TYPED, MODE_SCRATCH, MODE_BOTTOM_UP, MODE_PARALLEL, MODE_COUNT } sort_mode_t;
+const char *mode_names[MODE_COUNT] = {"Generic", "Typed", "Scratch", "Bottom-up", "Parallel"};
+
+int run_length = DEFAULT_RUN_LENGTH; // Insertion-sort run length used by the bottom-up mode (`--run N`)
+int thread_count = 1; // Number of threads used by the parallel mode (`--threads N`)
+sort_mode_t sort_mode = MODE_TYPED; // Sort strategy chosen on the command line
+
+// Arguments of one parallel task (a half to sort, or a slice of a merge) running on its own pthread
+typedef struct {
+    void *src, *dst;
+    int left, mid, right; // Sort: range [left..right]; merge: runs [left..mid] and [mid+1..right]
+    int begin, end;       // Merge: output positions [begin, end) relative to `left` handled by this task
+    int threads;          // Threads this task may use
+} parallel_task_t;
+
+// One sorted run of the external sort: a temporary file of binary ints read back through a block buffer
+typedef struct {
+    FILE *file;
+    int *buffer;
+    int capacity, count, position;
+    int exhausted;
+} run_reader_t;
+
+// A batch of independent arrays sorted in place by `sort_batch()`
+typedef struct {
+    char *data;            // Per array a uint32_t element count followed by the elements
+    const size_t *offsets; // Byte offset of every array's count in `data`
+    int count;             // Number of arrays
+    char type;             // Element type ('i', 'f', 'c')
+    int next;              // Index of the first array no worker has taken yet (updated atomically)
+} batch_t;
+
+// Sort key of a record packed with its index: the key mapped to an order-preserving unsigned value in the high
+// 32 bits, the record index in the low 32 bits. Ties are broken by the index, so one integer compare is a stable compare.
+typedef uint64_t record_key_t;
+
+// Sort key of a record with a string key: the key pointer and the record index
+typedef struct {
+    string_t key;
+    int index;
+} record_ref_t;
+
+// One worker thread of `sort_batch()`
+typedef struct {
+    batch_t *batch;
+    size_t scratch_allocations; // Times this worker had to grow its scratch buffer
+} batch_worker_t;
 
 void merge_sort(void *arr, int left, int right, char type, int *step, int visualize);
+void merge_sort_int(int *arr, int left, int right, int *step, int visualize);
+void merge_sort_float(float *arr, int left, int right, int *step, int visualize);
+void merge_sort_char(char *arr, int left, int right, int *step, int visualize);
+void merge_sort_string(string_t *arr, int left, int right, int *step, int visualize);
+void merge_sort_generic(void *arr, int left, int right, char type, int *step, int visualize);
+void merge_sort_scratch(void *arr, int size, char type);
+void merge_sort_scratch_int(int *src, int *dst, int left, int right);
+void merge_sort_scratch_float(float *src, float *dst, int left, int right);
+void merge_sort_scratch_char(char *src, char *dst, int left, int right);
+void merge_sort_scratch_string(string_t *src, string_t *dst, int left, int right);
+void merge_sort_bottom_up(void *arr, int size, char type, int run, int visualize);
+void merge_sort_bottom_up_int(int *arr, int *scratch, int size, int run, int visualize);
+void merge_sort_bottom_up_float(float *arr, float *scratch, int size, int run, int visualize);
+void merge_sort_bottom_up_char(char *arr, char *scratch, int size, int run, int visualize);
+void merge_sort_bottom_up_string(string_t *arr, string_t *scratch, int size, int run, int visualize);
+void merge_sort_parallel(void *arr, int size, char type, int threads);
+void merge_sort_parallel_int(int *src, int *dst, int left, int right, int threads);
+void merge_sort_parallel_float(float *src, float *dst, int left, int right, int threads);
+void merge_sort_parallel_char(char *src, char *dst, int left, int right, int threads);
+void merge_sort_parallel_string(string_t *src, string_t *dst, int left, int right, int threads);
+void run_scaling_benchmark(int size, int max_threads);
+int external_merge_sort(const char *input_path, const char *output_path, size_t memory_bytes, sort_mode_t mode);
+int merge_runs(FILE **files, int count, int block, FILE *out, int text);
+void close_runs(FILE **files, int count);
+int read_int_chunk(text_reader_t *in, int *chunk, int capacity);
+void write_int_text(FILE *out, int value);
+int run_reader_advance(run_reader_t *run);
+int run_precedes(run_reader_t *runs, int a, int b);
+int batch_sort_file(const char *input_path, const char *output_path, char type, int threads);
+int index_batch(char *data, size_t bytes, char type, size_t **offsets);
+void batch_swap_order(char *data, size_t bytes, char type, int to_host);
+size_t sort_batch(batch_t *batch, int threads);
+void *batch_worker(void *arg);
+void run_batch_benchmark(int count, int max_threads);
+void run_parse_benchmark(int megabytes);
+void merge_sort_records(void *records, int count, size_t record_size, size_t key_offset, char key_type);
+int *merge_sort_record_order(const void *records, int count, size_t record_size, size_t key_offset, char key_type);
+void merge_sort_bottom_up_record_key(record_key_t *arr, record_key_t *scratch, int size, int run, int visualize);
+void merge_sort_bottom_up_record_ref(record_ref_t *arr, record_ref_t *scratch, int size, int run, int visualize);
+void permute_records(void *records, int *order, int count, size_t record_size);
+void merge_sort_records_direct(void *records, int count, size_t record_size, size_t key_offset, char key_type);
+int record_precedes(const char *a, const char *b, size_t key_offset, char key_type);
+void run_record_benchmark(int count);
+void sort_with_mode(void *arr, int size, char type, sort_mode_t mode, int visualize);
+void sort_file_array(void *arr, int size, char type);
+void *counted_malloc(size_t bytes);
+int compare_elements(const void *a, const void *b, char type);
+int compare_int(const void *a, const void *b);
+int compare_float(const void *a, const void *b);
+int compare_char(const void *a, const void *b);
+int compare_string(const void *a, const void *b);
+string_t *read_strings(int size, char **arena);
+int matches_reference(void *arr, void *reference, int size, char type);
+size_t element_size(char type);
+void run_benchmark(int size);
+double now_seconds(void);
 void print_array(void *arr, int size, char type);
 void print_array_with_range(void *arr, int size, char type, int left, int right, int mid);
 
 int main(int argc, char *argv[]) {
     int visualize = 0;
-    if (argc > 1) if (strcmp(argv[1], "-v") == 0 || strcmp(argv[1], "--visualize") == 0) visualize = 1; // Enable visualization if -v or --visualize is passed
+    int benchmark_size = 0;
+    int scaling_size = 0;
+    int external = 0;
+    int batch = 0;
+    int batch_benchmark_count = 0;
+    int parse_benchmark_mb = 0;
+    int record_benchmark_count = 0;
+    char batch_type = 'i';
+    const char *input_path = NULL, *output_path = NULL, *format = NULL;
+    size_t memory_mb = DEFAULT_MEMORY_MB;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0 || strcmp(argv[i], "--visualize") == 0) visualize = 1; // Enable visualization if -v or --visualize is passed
+        else if (strcmp(argv[i], "--benchmark") == 0 && i + 1 < argc) benchmark_size = atoi(argv[++i]); // Benchmark every sort mode on N random elements per type
+        else if (strcmp(argv[i], "--scratch") == 0) sort_mode = MODE_SCRATCH; // Use a single preallocated scratch buffer instead of per-merge allocations
+        else if (strcmp(argv[i], "--bottom-up") == 0) sort_mode = MODE_BOTTOM_UP; // Non-recursive bottom-up merge sort
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) { // Parallel merge sort on N threads
+            sort_mode = MODE_PARALLEL;
+            thread_count = atoi(argv[++i]) > 0 ? atoi(argv[i]) : 1;
+            if (thread_count > MAX_THREADS) {
+                fprintf(stderr, YELLOW "--threads is capped at %d.\n" RESET, MAX_THREADS);
+                thread_count = MAX_THREADS;
+            }
+        }
+        else if (strcmp(argv[i], "--scaling") == 0 && i + 1 < argc) scaling_size = atoi(argv[++i]); // Parallel scaling benchmark on N random integers
+        else if (strcmp(argv[i], "--run") == 0 && i + 1 < argc) run_length = atoi(argv[++i]) > 0 ? atoi(argv[i]) : DEFAULT_RUN_LENGTH; // Insertion-sort run length for bottom-up mode
+        else if (strcmp(argv[i], "--external") == 0) external = 1; // Out-of-core sort of an integer file (`--in`, `--out`, `--mem`)
+        else if (strcmp(argv[i], "--in") == 0 && i + 1 < argc) input_path = argv[++i]; // Input file of --external, --batch or --format
+        else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) output_path = argv[++i]; // Output file of --external, --batch or --format (default: stdout)
+        else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) format = argv[++i]; // Sort an array file without prompts: i32, f32, u8 or lines
+        else if (strcmp(argv[i], "--mem") == 0 && i + 1 < argc) memory_mb = atoi(argv[++i]) > 0 ? (size_t)atoi(argv[i]) : DEFAULT_MEMORY_MB;
+        else if (strcmp(argv[i], "--batch") == 0) batch = 1; // Sort every length-prefixed array of a binary file (`--in`, `--out`, `--type`, `--threads`)
+        else if (strcmp(argv[i], "--type") == 0 && i + 1 < argc) batch_type = argv[++i][0]; // Element type of the batch file: i, f or c
+        else if (strcmp(argv[i], "--batch-benchmark") == 0 && i + 1 < argc) batch_benchmark_count = atoi(argv[++i]); // Batch throughput on N random small arrays
+        else if (strcmp(argv[i], "--parse-benchmark") == 0 && i + 1 < argc) parse_benchmark_mb = atoi(argv[++i]); // Text reader vs scanf on MB of comma-separated integers
+        else if (strcmp(argv[i], "--record-benchmark") == 0 && i + 1 < argc) record_benchmark_count = atoi(argv[++i]); // Stable record sort on N records with 64-byte payloads
+    }
+
+    // Batch mode uses every core unless `--threads N` says otherwise
+    int batch_threads = sort_mode == MODE_PARALLEL ? thread_count : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (batch_threads < 1) batch_threads = 1;
+    if (batch) {
+        if (!input_path || !output_path) {
+            printf(RED "Batch sort needs --in FILE and --out FILE!\n" RESET);
+            return 1;
+        }
+        return batch_sort_file(input_path, output_path, batch_type, batch_threads);
+    }
+    if (batch_benchmark_count > 0) {
+        run_batch_benchmark(batch_benchmark_count, batch_threads);
+        return 0;
+    }
+    if (parse_benchmark_mb > 0) {
+        run_parse_benchmark(parse_benchmark_mb);
+        return 0;
+    }
+    if (record_benchmark_count > 0) {
+        run_record_benchmark(record_benchmark_count);
+        return 0;
+    }
 
+    if (external) {
+        if (!input_path || !output_path) {
+            printf(RED "External sort needs --in FILE and --out FILE!\n" RESET);
+            return 1;
+        }
+        return external_merge_sort(input_path, output_path, memory_mb << 20, sort_mode);
+    }
+    if (input_path) return sort_array_file(input_path, output_path, format, sort_file_array);
+
+    if (benchmark_size > 0) {
+        run_benchmark(benchmark_size);
+        return 0;
+    }
+    if (scaling_size > 0) {
+        run_scaling_benchmark(scaling_size, thread_count);
+        return 0;
+    }
+
+    setvbuf(stdin, NULL, _IONBF, 0); // The number prompts read stdin with `read()` (text_reader.h), so stdio must not read ahead
     int choice;
     printf(MAGENTA "Merge Sort\n");
     printf("==========\n" RESET);
     if (visualize) printf(BG_YELLOW "Visualization enabled." RESET "\n");
+    if ((sort_mode == MODE_SCRATCH || sort_mode == MODE_PARALLEL) && visualize) printf(YELLOW "%s mode is not visualized, using per-merge allocations.\n" RESET, mode_names[sort_mode]);
     printf("Choose data type:\n");
     printf("1. Integers\n");
     printf("2. Floats\n");
@@ -40,6 +249,7 @@ int main(int argc, char *argv[]) {
 
     char type = 0;
     void *arr = NULL;
+    char *arena = NULL; // Backing storage of the strings when sorting 's' (`arr` then holds pointers into it)
 
     switch(choice) {
         // For integers
@@ -47,9 +257,12 @@ int main(int argc, char *argv[]) {
             type = 'i';
             arr = malloc(size * sizeof(int));
 
+            text_reader_t reader;
+            text_reader_open(&reader, STDIN_FILENO);
             printf("Enter %d integers: ", size);
-            for (int i = 0; i < size; i++) scanf("%*[^0-9]%d", &((int*)arr)[i]);
-            while (getchar() != '\n'); // Clear input buffer
+            for (int i = 0; i < size; i++) text_reader_int(&reader, &((int*)arr)[i]);
+            text_reader_skip_line(&reader); // Clear input buffer
+            text_reader_close(&reader);
             break;
         }
         // For floats
@@ -57,9 +270,12 @@ int main(int argc, char *argv[]) {
             type = 'f';
             arr = malloc(size * sizeof(float));
 
+            text_reader_t reader;
+            text_reader_open(&reader, STDIN_FILENO);
             printf("Enter %d floats: ", size);
-            for (int i = 0; i < size; i++) scanf("%*[^0-9.]%f", &((float*)arr)[i]);
-            while (getchar() != '\n'); // Clear input buffer
+            for (int i = 0; i < size; i++) text_reader_float(&reader, &((float*)arr)[i]);
+            text_reader_skip_line(&reader); // Clear input buffer
+            text_reader_close(&reader);
             break;
         }
         // For characters
@@ -75,10 +291,9 @@ int main(int argc, char *argv[]) {
         // For strings
         case 4: {
             type = 's';
-            arr = malloc(size * STRING_LENGTH * sizeof(char));
 
             printf("Enter %d strings: ", size);
-            for (int i = 0; i < size; i++) scanf("%s", ((char(*)[STRING_LENGTH])arr)[i]);
+            arr = read_strings(size, &arena);
             while (getchar() != '\n'); // Clear input buffer
             break;
         }
@@ -96,20 +311,1367 @@ int main(int argc, char *argv[]) {
 
     printf(DIM "Sorting...\n" RESET);
     if (visualize) printf(BOLD "\nStep-by-step sorting:\n" RESET);
-    int step = 1;
-    merge_sort(arr, 0, size - 1, type, &step, visualize);
+    sort_with_mode(arr, size, type, sort_mode, visualize);
 
     printf(GREEN "\n-- Sorted Array\n" RESET BOLD);
     print_array(arr, size, type);
     printf(RESET);
+    printf(DIM "Allocations: %zu (%zu bytes)\n" RESET, allocation_count, allocation_bytes);
 
     free(arr);
+    free(arena);
     return 0;
 }
 
 /**
  * Performs merge sort on an array of various types.
  *
+ * The element type is resolved once here and the call is dispatched to a type-specialized kernel,
+ * so the merge loop itself never branches on `type`.
+ *
+ * Supported types:
+ * - 'i' for int
+ * - 'f' for float
+ * - 'c' for char
+ * - 's' for string (char*) - pointers into one string arena, strings of any length.
+ *
+ * @param arr       Pointer to the array to sort.
+ * @param left      Left boundary of the subarray.
+ * @param right     Right boundary of the subarray.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @param step      Pointer to step counter for visualization.
+ * @param visualize Flag to enable step-by-step visualization. (1 = enable, 0 = disable)
+ * @return          void
+ */
+void merge_sort(void *arr, int left, int right, char type, int *step, int visualize) {
+    // Up to 16 ints or floats: one sorting network, no recursion and no merges (equal numbers are interchangeable)
+    if (!visualize && sort_network((char*)arr + (size_t)left * element_size(type), right - left + 1, type)) return;
+
+    switch (type) {
+        case 'i': merge_sort_int((int*)arr, left, right, step, visualize); break;
+        case 'f': merge_sort_float((float*)arr, left, right, step, visualize); break;
+        case 'c': merge_sort_char((char*)arr, left, right, step, visualize); break;
+        case 's': merge_sort_string((string_t*)arr, left, right, step, visualize); break;
+        default: return; // Unknown type
+    }
+}
+
+// Comparison used by the kernels to keep the merge stable (take from the left run on ties)
+#define NUMBER_LESS_EQ(a, b) ((a) <= (b))
+#define STRING_LESS_EQ(a, b) (strcmp((a), (b)) <= 0)
+
+// Moves the smaller head of runs `a[i]` / `b[j]` into `out[k]` with a branch (floats and strings)
+#define MERGE_STEP_BRANCHY(T, out, k, a, i, b, j, less_eq)                                                                     \
+    if (less_eq(a[i], b[j])) out[k++] = a[i++];                                                                                 \
+    else out[k++] = b[j++];
+
+// Branch-free variant for integer keys: the head is picked with a conditional move and both cursors advance arithmetically,
+// so random input does not pay for a mispredicted branch on every element
+#define MERGE_STEP_BRANCHLESS(T, out, k, a, i, b, j, less_eq)                                                                  \
+    {                                                                                                                           \
+        T left_value = a[i], right_value = b[j];                                                                                \
+        int take_left = less_eq(left_value, right_value);                                                                       \
+        out[k++] = take_left ? left_value : right_value;                                                                        \
+        i += take_left;                                                                                                         \
+        j += !take_left;                                                                                                        \
+    }
+
+/**
+ * Defines a merge sort kernel specialized for one element type.
+ *
+ * Each expansion is a plain recursive merge sort over `T*`, so element copies are direct assignments
+ * and the comparison is inlined - no per-element `switch (type)`.
+ *
+ * @param name      Name of the generated function.
+ * @param T         Element type.
+ * @param type_code Type code passed to the print helpers for visualization ('i', 'f', 'c', 's').
+ * @param less_eq   Comparison macro `less_eq(a, b)`, true when `a` should come first.
+ * @param merge_step Merge step macro, `MERGE_STEP_BRANCHY` or `MERGE_STEP_BRANCHLESS`.
+ */
+#define DEFINE_MERGE_SORT_KERNEL(name, T, type_code, less_eq, merge_step)                                                                \
+void name(T *arr, int left, int right, int *step, int visualize) {                                                           \
+    if (left >= right) return;                                                                                                  \
+                                                                                                                                \
+    int mid = left + (right - left) / 2;                                                                                        \
+                                                                                                                                \
+    if (visualize) {                                                                                                            \
+        printf(CYAN "Step %d: Dividing array [%d-%d] at mid=%d -> " RESET, (*step)++, left, right, mid);                       \
+        print_array_with_range(arr, right + 1, type_code, left, right, mid);                                                    \
+    }                                                                                                                           \
+                                                                                                                                \
+    /* Recursively sort first and second halves */                                                                              \
+    name(arr, left, mid, step, visualize);                                                                                      \
+    name(arr, mid + 1, right, step, visualize);                                                                                 \
+                                                                                                                                \
+    /* Copy both halves into temporary arrays */                                                                                \
+    int n1 = mid - left + 1;                                                                                                    \
+    int n2 = right - mid;                                                                                                       \
+    T *left_arr = counted_malloc(n1 * sizeof(T));                                                                               \
+    T *right_arr = counted_malloc(n2 * sizeof(T));                                                                              \
+    memcpy(left_arr, arr + left, n1 * sizeof(T));                                                                               \
+    memcpy(right_arr, arr + mid + 1, n2 * sizeof(T));                                                                           \
+                                                                                                                                \
+    if (visualize) {                                                                                                            \
+        printf(BLUE "Step %d: Merging subarrays [%d-%d] and [%d-%d] -> " RESET, (*step)++, left, mid, mid + 1, right);          \
+        print_array_with_range(arr, right + 1, type_code, left, right, -1);                                                     \
+    }                                                                                                                           \
+                                                                                                                                \
+    /* Merge the temporary arrays back into arr[left..right] */                                                                 \
+    int i = 0, j = 0, k = left;                                                                                                 \
+    while (i < n1 && j < n2) {                                                                                                  \
+        merge_step(T, arr, k, left_arr, i, right_arr, j, less_eq)                                                               \
+    }                                                                                                                           \
+    while (i < n1) arr[k++] = left_arr[i++];                                                                                    \
+    while (j < n2) arr[k++] = right_arr[j++];                                                                                   \
+                                                                                                                                \
+    if (visualize) {                                                                                                            \
+        printf(GREEN "    ✓ Merged -> " RESET);                                                                                  \
+        print_array_with_range(arr, right + 1, type_code, left, right, -1);                                                     \
+    }                                                                                                                           \
+                                                                                                                                \
+    free(left_arr);                                                                                                             \
+    free(right_arr);                                                                                                            \
+}
+
+DEFINE_MERGE_SORT_KERNEL(merge_sort_int, int, 'i', NUMBER_LESS_EQ, MERGE_STEP_BRANCHLESS)
+DEFINE_MERGE_SORT_KERNEL(merge_sort_float, float, 'f', NUMBER_LESS_EQ, MERGE_STEP_BRANCHY)
+DEFINE_MERGE_SORT_KERNEL(merge_sort_char, char, 'c', NUMBER_LESS_EQ, MERGE_STEP_BRANCHY)
+DEFINE_MERGE_SORT_KERNEL(merge_sort_string, string_t, 's', STRING_LESS_EQ, MERGE_STEP_BRANCHY)
+
+/**
+ * Performs merge sort using one scratch buffer for the whole sort.
+ *
+ * A single `size`-element buffer is allocated up front and filled with a copy of the input. The
+ * kernels then ping-pong between the two buffers: each level sorts its halves into one buffer and
+ * merges them into the other, so no further heap allocations happen during the sort.
+ *
+ * Supported types:
+ * - 'i' for int
+ * - 'f' for float
+ * - 'c' for char
+ * - 's' for string (char*) - pointers into one string arena, strings of any length.
+ *
+ * @param arr       Pointer to the array to sort.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @return          void
+ */
+void merge_sort_scratch(void *arr, int size, char type) {
+    if (size < 2 || element_size(type) == 0) return;
+    if (sort_network(arr, size, type)) return; // Tiny int and float arrays skip the scratch buffer
+
+    void *scratch = counted_malloc(size * element_size(type));
+    memcpy(scratch, arr, size * element_size(type));
+
+    switch (type) {
+        case 'i': merge_sort_scratch_int((int*)scratch, (int*)arr, 0, size - 1); break;
+        case 'f': merge_sort_scratch_float((float*)scratch, (float*)arr, 0, size - 1); break;
+        case 'c': merge_sort_scratch_char((char*)scratch, (char*)arr, 0, size - 1); break;
+        case 's': merge_sort_scratch_string((string_t*)scratch, (string_t*)arr, 0, size - 1); break;
+    }
+
+    free(scratch);
+}
+
+/**
+ * Defines a ping-pong merge sort kernel specialized for one element type.
+ *
+ * The generated function sorts `src[left..right]` into `dst[left..right]`. Both ranges must hold the
+ * same elements on entry; the halves are sorted into `src` (using `dst` as their source) and then
+ * merged into `dst`, so the roles of the two buffers swap on every level.
+ *
+ * @param name      Name of the generated function.
+ * @param T         Element type.
+ * @param less_eq   Comparison macro `less_eq(a, b)`, true when `a` should come first.
+ * @param merge_step Merge step macro, `MERGE_STEP_BRANCHY` or `MERGE_STEP_BRANCHLESS`.
+ */
+#define DEFINE_MERGE_SORT_SCRATCH_KERNEL(name, T, less_eq, merge_step)                                                                   \
+void name(T *src, T *dst, int left, int right) {                                                                             \
+    if (left >= right) return; /* A single element is already in place in both buffers */                                     \
+                                                                                                                                \
+    int mid = left + (right - left) / 2;                                                                                        \
+    name(dst, src, left, mid);                                                                                                  \
+    name(dst, src, mid + 1, right);                                                                                             \
+                                                                                                                                \
+    /* Merge the sorted halves of src into dst */                                                                               \
+    int i = left, j = mid + 1, k = left;                                                                                        \
+    while (i <= mid && j <= right) {                                                                                            \
+        merge_step(T, dst, k, src, i, src, j, less_eq)                                                                          \
+    }                                                                                                                           \
+    while (i <= mid) dst[k++] = src[i++];                                                                                       \
+    while (j <= right) dst[k++] = src[j++];                                                                                     \
+}
+
+DEFINE_MERGE_SORT_SCRATCH_KERNEL(merge_sort_scratch_int, int, NUMBER_LESS_EQ, MERGE_STEP_BRANCHLESS)
+DEFINE_MERGE_SORT_SCRATCH_KERNEL(merge_sort_scratch_float, float, NUMBER_LESS_EQ, MERGE_STEP_BRANCHY)
+DEFINE_MERGE_SORT_SCRATCH_KERNEL(merge_sort_scratch_char, char, NUMBER_LESS_EQ, MERGE_STEP_BRANCHY)
+DEFINE_MERGE_SORT_SCRATCH_KERNEL(merge_sort_scratch_string, string_t, STRING_LESS_EQ, MERGE_STEP_BRANCHY)
+
+/**
+ * Performs a non-recursive (bottom-up) merge sort.
+ *
+ * The array is cut into runs of `run` elements that are sorted with insertion sort, then the runs
+ * are merged in passes of doubling width, ping-ponging between the array and one scratch buffer.
+ * There is no recursion, so stack depth does not grow with the input size.
+ *
+ * Supported types:
+ * - 'i' for int
+ * - 'f' for float
+ * - 'c' for char
+ * - 's' for string (char*) - pointers into one string arena, strings of any length.
+ *
+ * @param arr       Pointer to the array to sort.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @param run       Number of elements per insertion-sorted run (e.g. 16-32).
+ * @param visualize Flag to enable pass-by-pass visualization. (1 = enable, 0 = disable)
+ * @return          void
+ */
+void merge_sort_bottom_up(void *arr, int size, char type, int run, int visualize) {
+    if (size < 2 || element_size(type) == 0) return;
+    if (!visualize && sort_network(arr, size, type)) return; // Tiny int and float arrays skip the scratch buffer
+    if (run < 1) run = 1;
+
+    void *scratch = counted_malloc(size * element_size(type));
+
+    switch (type) {
+        case 'i': merge_sort_bottom_up_int((int*)arr, (int*)scratch, size, run, visualize); break;
+        case 'f': merge_sort_bottom_up_float((float*)arr, (float*)scratch, size, run, visualize); break;
+        case 'c': merge_sort_bottom_up_char((char*)arr, (char*)scratch, size, run, visualize); break;
+        case 's': merge_sort_bottom_up_string((string_t*)arr, (string_t*)scratch, size, run, visualize); break;
+    }
+
+    free(scratch);
+}
+
+/**
+ * Defines a bottom-up merge sort kernel specialized for one element type.
+ *
+ * The generated function insertion-sorts every `run`-sized block of `arr`, then merges neighbouring
+ * blocks between `arr` and `scratch` with doubling width until one block remains. The result always
+ * ends up in `arr`.
+ *
+ * @param name      Name of the generated function.
+ * @param T         Element type.
+ * @param type_code Type code passed to the print helpers for visualization ('i', 'f', 'c', 's').
+ * @param less_eq   Comparison macro `less_eq(a, b)`, true when `a` should come first.
+ * @param merge_step Merge step macro, `MERGE_STEP_BRANCHY` or `MERGE_STEP_BRANCHLESS`.
+ */
+#define DEFINE_MERGE_SORT_BOTTOM_UP_KERNEL(name, T, type_code, less_eq, merge_step)                                            \
+void name(T *arr, T *scratch, int size, int run, int visualize) {                                                            \
+    /* Sort small runs in place with (stable) insertion sort */                                                                 \
+    for (int start = 0; start < size; start += run) {                                                                           \
+        int end = start + run < size ? start + run : size;                                                                      \
+        for (int i = start + 1; i < end; i++) {                                                                                 \
+            T value = arr[i];                                                                                                   \
+            int j = i - 1;                                                                                                      \
+            while (j >= start && !less_eq(arr[j], value)) {                                                                     \
+                arr[j + 1] = arr[j];                                                                                            \
+                j--;                                                                                                            \
+            }                                                                                                                   \
+            arr[j + 1] = value;                                                                                                 \
+        }                                                                                                                       \
+    }                                                                                                                           \
+                                                                                                                                \
+    if (visualize) {                                                                                                            \
+        printf(CYAN "Runs of %d sorted with insertion sort -> " RESET, run);                                                    \
+        print_array(arr, size, type_code);                                                                                      \
+    }                                                                                                                           \
+                                                                                                                                \
+    /* Merge neighbouring runs in widening passes */                                                                            \
+    T *src = arr, *dst = scratch;                                                                                               \
+    for (int width = run; width < size; width *= 2) {                                                                           \
+        for (int left = 0; left < size; left += 2 * width) {                                                                    \
+            int mid = left + width < size ? left + width : size;                                                                \
+            int right = mid + width < size ? mid + width : size;                                                                \
+            int i = left, j = mid, k = left;                                                                                    \
+            while (i < mid && j < right) {                                                                                      \
+                merge_step(T, dst, k, src, i, src, j, less_eq)                                                                  \
+            }                                                                                                                   \
+            while (i < mid) dst[k++] = src[i++];                                                                                \
+            while (j < right) dst[k++] = src[j++];                                                                              \
+        }                                                                                                                       \
+                                                                                                                                \
+        T *temp = src;                                                                                                          \
+        src = dst;                                                                                                              \
+        dst = temp;                                                                                                             \
+                                                                                                                                \
+        if (visualize) {                                                                                                        \
+            printf(BLUE "Merged runs of %d -> " RESET, width);                                                                  \
+            print_array(src, size, type_code);                                                                                  \
+        }                                                                                                                       \
+    }                                                                                                                           \
+                                                                                                                                \
+    if (src != arr) memcpy(arr, src, size * sizeof(T));                                                                         \
+}
+
+DEFINE_MERGE_SORT_BOTTOM_UP_KERNEL(merge_sort_bottom_up_int, int, 'i', NUMBER_LESS_EQ, MERGE_STEP_BRANCHLESS)
+DEFINE_MERGE_SORT_BOTTOM_UP_KERNEL(merge_sort_bottom_up_float, float, 'f', NUMBER_LESS_EQ, MERGE_STEP_BRANCHY)
+DEFINE_MERGE_SORT_BOTTOM_UP_KERNEL(merge_sort_bottom_up_char, char, 'c', NUMBER_LESS_EQ, MERGE_STEP_BRANCHY)
+DEFINE_MERGE_SORT_BOTTOM_UP_KERNEL(merge_sort_bottom_up_string, string_t, 's', STRING_LESS_EQ, MERGE_STEP_BRANCHY)
+
+// Record sort keys (`merge_sort_record_order()`); never visualized, so the type code is unused
+#define RECORD_REF_LESS_EQ(a, b) (strcmp((a).key, (b).key) <= 0)
+DEFINE_MERGE_SORT_BOTTOM_UP_KERNEL(merge_sort_bottom_up_record_key, record_key_t, 0, NUMBER_LESS_EQ, MERGE_STEP_BRANCHLESS)
+DEFINE_MERGE_SORT_BOTTOM_UP_KERNEL(merge_sort_bottom_up_record_ref, record_ref_t, 0, RECORD_REF_LESS_EQ, MERGE_STEP_BRANCHY)
+
+/**
+ * Performs merge sort on several threads.
+ *
+ * The two halves of every subarray larger than `PARALLEL_CUTOFF` are sorted as separate pthread tasks,
+ * each getting half of the thread budget, so at most `threads` threads run at once. The merge of two
+ * sorted halves is parallelized as well: the output is cut into equal slices and the matching split
+ * points in both halves are found by co-ranking (binary search), so every thread merges its slice
+ * independently. Below the cutoff the single-threaded scratch kernels are used.
+ *
+ * Supported types:
+ * - 'i' for int
+ * - 'f' for float
+ * - 'c' for char
+ * - 's' for string (char*) - pointers into one string arena, strings of any length.
+ *
+ * @param arr       Pointer to the array to sort.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @param threads   Maximum number of threads to use.
+ * @return          void
+ */
+void merge_sort_parallel(void *arr, int size, char type, int threads) {
+    if (size < 2 || element_size(type) == 0) return;
+    if (sort_network(arr, size, type)) return; // Tiny int and float arrays skip the scratch buffer
+    if (threads < 1) threads = 1;
+
+    void *scratch = counted_malloc(size * element_size(type));
+    memcpy(scratch, arr, size * element_size(type));
+
+    switch (type) {
+        case 'i': merge_sort_parallel_int((int*)scratch, (int*)arr, 0, size - 1, threads); break;
+        case 'f': merge_sort_parallel_float((float*)scratch, (float*)arr, 0, size - 1, threads); break;
+        case 'c': merge_sort_parallel_char((char*)scratch, (char*)arr, 0, size - 1, threads); break;
+        case 's': merge_sort_parallel_string((string_t*)scratch, (string_t*)arr, 0, size - 1, threads); break;
+    }
+
+    free(scratch);
+}
+
+/**
+ * Defines a parallel ping-pong merge sort kernel specialized for one element type.
+ *
+ * Like the scratch kernels, the generated `name(src, dst, left, right, threads)` sorts `src[left..right]`
+ * into `dst[left..right]` (both holding the same elements on entry). Besides `name` it generates:
+ * - `name##_corank`: number of elements of run `a` among the first `k` outputs of a stable merge of `a` and `b`
+ * - `name##_merge_slice`: pthread entry merging output positions [begin, end) of one merge
+ * - `name##_sort_half`: pthread entry sorting one half
+ *
+ * @param name       Name of the generated function.
+ * @param T          Element type.
+ * @param less_eq    Comparison macro `less_eq(a, b)`, true when `a` should come first.
+ * @param merge_step Merge step macro, `MERGE_STEP_BRANCHY` or `MERGE_STEP_BRANCHLESS`.
+ * @param sequential Single-threaded scratch kernel used below `PARALLEL_CUTOFF`.
+ */
+#define DEFINE_MERGE_SORT_PARALLEL_KERNEL(name, T, less_eq, merge_step, sequential)                                            \
+static int name##_corank(T *a, int n1, T *b, int n2, int k) {                                                                 \
+    int low = k > n2 ? k - n2 : 0, high = k < n1 ? k : n1;                                                                      \
+    while (low < high) {                                                                                                        \
+        int i = low + (high - low) / 2;                                                                                         \
+        if (less_eq(a[i], b[k - i - 1])) low = i + 1; /* a[i] is merged before b[k-i-1], so more of `a` is needed */           \
+        else high = i;                                                                                                          \
+    }                                                                                                                           \
+    return low;                                                                                                                 \
+}                                                                                                                               \
+                                                                                                                                \
+static void *name##_merge_slice(void *arg) {                                                                                   \
+    parallel_task_t *task = arg;                                                                                                \
+    T *src = task->src, *dst = task->dst;                                                                                       \
+    T *a = src + task->left, *b = src + task->mid + 1;                                                                          \
+    int n1 = task->mid - task->left + 1, n2 = task->right - task->mid;                                                          \
+    int i = name##_corank(a, n1, b, n2, task->begin), i_end = name##_corank(a, n1, b, n2, task->end);                           \
+    int j = task->begin - i, j_end = task->end - i_end;                                                                         \
+    T *out = dst + task->left;                                                                                                  \
+    int k = task->begin;                                                                                                        \
+    while (i < i_end && j < j_end) {                                                                                            \
+        merge_step(T, out, k, a, i, b, j, less_eq)                                                                              \
+    }                                                                                                                           \
+    while (i < i_end) out[k++] = a[i++];                                                                                        \
+    while (j < j_end) out[k++] = b[j++];                                                                                        \
+    return NULL;                                                                                                                \
+}                                                                                                                               \
+                                                                                                                                \
+static void *name##_sort_half(void *arg) {                                                                                     \
+    parallel_task_t *task = arg;                                                                                                \
+    name(task->src, task->dst, task->left, task->right, task->threads);                                                         \
+    return NULL;                                                                                                                \
+}                                                                                                                               \
+                                                                                                                                \
+void name(T *src, T *dst, int left, int right, int threads) {                                                                \
+    if (threads < 2 || right - left + 1 < PARALLEL_CUTOFF) {                                                                    \
+        sequential(src, dst, left, right);                                                                                      \
+        return;                                                                                                                 \
+    }                                                                                                                           \
+                                                                                                                                \
+    /* Sort the halves (into src) concurrently: left half on a new thread, right half here */                                   \
+    int mid = left + (right - left) / 2;                                                                                        \
+    parallel_task_t half = {dst, src, left, 0, mid, 0, 0, threads / 2};                                                         \
+    pthread_t worker;                                                                                                           \
+    int spawned = pthread_create(&worker, NULL, name##_sort_half, &half) == 0;                                                  \
+    if (!spawned) name##_sort_half(&half);                                                                                      \
+    name(dst, src, mid + 1, right, threads - threads / 2);                                                                      \
+    if (spawned) pthread_join(worker, NULL);                                                                                    \
+                                                                                                                                \
+    /* Merge the halves into dst, one output slice per thread, each slice at least PARALLEL_CUTOFF elements */                  \
+    int total = right - left + 1;                                                                                               \
+    int count = total / PARALLEL_CUTOFF < threads ? total / PARALLEL_CUTOFF : threads;                                          \
+    parallel_task_t *slices = malloc(count * sizeof(parallel_task_t));                                                          \
+    pthread_t *workers = malloc(count * sizeof(pthread_t));                                                                     \
+    int *started = calloc(count, sizeof(int));                                                                                  \
+    if (!slices || !workers || !started) { /* Out of memory: one slice covering the whole merge */                              \
+        parallel_task_t whole = {src, dst, left, mid, right, 0, total, 1};                                                      \
+        name##_merge_slice(&whole);                                                                                             \
+        free(slices); free(workers); free(started);                                                                             \
+        return;                                                                                                                 \
+    }                                                                                                                           \
+    for (int t = 0; t < count; t++) {                                                                                           \
+        slices[t] = (parallel_task_t) {src, dst, left, mid, right, (int)((long long)total * t / count),                         \
+                                       (int)((long long)total * (t + 1) / count), 1};                                           \
+        started[t] = t > 0 && pthread_create(&workers[t], NULL, name##_merge_slice, &slices[t]) == 0;                           \
+        if (t > 0 && !started[t]) name##_merge_slice(&slices[t]);                                                               \
+    }                                                                                                                           \
+    name##_merge_slice(&slices[0]);                                                                                             \
+    for (int t = 1; t < count; t++) if (started[t]) pthread_join(workers[t], NULL);                                             \
+    free(slices);                                                                                                               \
+    free(workers);                                                                                                              \
+    free(started);                                                                                                              \
+}
+
+DEFINE_MERGE_SORT_PARALLEL_KERNEL(merge_sort_parallel_int, int, NUMBER_LESS_EQ, MERGE_STEP_BRANCHLESS, merge_sort_scratch_int)
+DEFINE_MERGE_SORT_PARALLEL_KERNEL(merge_sort_parallel_float, float, NUMBER_LESS_EQ, MERGE_STEP_BRANCHY, merge_sort_scratch_float)
+DEFINE_MERGE_SORT_PARALLEL_KERNEL(merge_sort_parallel_char, char, NUMBER_LESS_EQ, MERGE_STEP_BRANCHY, merge_sort_scratch_char)
+DEFINE_MERGE_SORT_PARALLEL_KERNEL(merge_sort_parallel_string, string_t, STRING_LESS_EQ, MERGE_STEP_BRANCHY, merge_sort_scratch_string)
+
+/**
+ * Sorts a text file of integers that may be larger than RAM (external merge sort).
+ *
+ * Phase 1 reads the input in chunks that fit into half of `memory_bytes`, sorts each chunk in memory
+ * (the other half is the merge scratch buffer) and writes it as a binary run to a temporary file.
+ * Phase 2 merges the runs with a loser tree, at most `fan_in` at a time: every run is read through a
+ * block buffer and `fan_in * block` integers fit into `memory_bytes`. While there are more runs than
+ * that, groups of `fan_in` runs are merged into longer temporary runs; the last pass writes the result
+ * as one integer per line. Memory use stays bounded by `memory_bytes` (plus the input and stdio
+ * buffers), and at most `MERGE_FAN_IN_MAX` run files are open during a merge, whatever the input size.
+ *
+ * The input is parsed leniently like the interactive reader: anything that is not a digit or a minus
+ * sign separates numbers.
+ *
+ * @param input_path  Path of the text file to sort.
+ * @param output_path Path of the sorted output file.
+ * @param memory_bytes Memory budget in bytes.
+ * @param mode        In-memory sort used for the runs (`MODE_PARALLEL` uses `thread_count` threads,
+ *                        anything else uses `MODE_BOTTOM_UP`).
+ * @return            0 on success, 1 on error.
+ */
+int external_merge_sort(const char *input_path, const char *output_path, size_t memory_bytes, sort_mode_t mode) {
+    printf(MAGENTA "External Merge Sort\n");
+    printf("===================\n" RESET);
+
+    int input_fd = open(input_path, O_RDONLY);
+    if (input_fd < 0) {
+        printf(RED "Cannot open input file '%s'!\n" RESET, input_path);
+        return 1;
+    }
+    text_reader_t in;
+    text_reader_open(&in, input_fd);
+
+    // Phase 1: sort memory-sized chunks into temporary run files
+    int chunk_capacity = (int)(memory_bytes / (2 * sizeof(int)) < 1024 ? 1024 : memory_bytes / (2 * sizeof(int)));
+    int *chunk = malloc(chunk_capacity * sizeof(int));
+    FILE **run_files = NULL;
+    int run_count = 0;
+    long long total = 0;
+
+    double start = now_seconds();
+    int count = 0;
+    while (chunk && (count = read_int_chunk(&in, chunk, chunk_capacity)) > 0) {
+        sort_with_mode(chunk, count, 'i', mode == MODE_PARALLEL ? MODE_PARALLEL : MODE_BOTTOM_UP, 0);
+
+        FILE *run = tmpfile();
+        FILE **grown = realloc(run_files, (run_count + 1) * sizeof(FILE*));
+        if (grown) run_files = grown;
+        if (!run || !grown || fwrite(chunk, sizeof(int), count, run) != (size_t)count || fflush(run) != 0) {
+            if (run) fclose(run);
+            break;
+        }
+        rewind(run);
+
+        run_files[run_count++] = run;
+        total += count;
+    }
+    text_reader_close(&in);
+    close(input_fd);
+    free(chunk);
+    if (!chunk || count > 0) {
+        printf(RED "Cannot write temporary run file!\n" RESET);
+        close_runs(run_files, run_count);
+        return 1;
+    }
+    printf("Phase 1: %lld integers -> %d sorted run%s (%.2f s)\n", total, run_count, run_count == 1 ? "" : "s", now_seconds() - start);
+
+    // Phase 2: merge at most `fan_in` runs at a time, so that their block buffers fit into the budget
+    int fan_in = (int)(memory_bytes / sizeof(int) / MERGE_BLOCK_MIN);
+    if (fan_in > MERGE_FAN_IN_MAX) fan_in = MERGE_FAN_IN_MAX;
+    if (fan_in < 2) fan_in = 2;
+    int block = (int)(memory_bytes / sizeof(int) / fan_in);
+    int initial_runs = run_count, passes = 1;
+
+    start = now_seconds();
+    while (run_count > fan_in) {
+        // Merge every group of `fan_in` runs into one longer run; the merged runs take the front slots of `run_files`
+        int merged_count = 0;
+        for (int first = 0; first < run_count; first += fan_in) {
+            int group = run_count - first < fan_in ? run_count - first : fan_in;
+            FILE *merged = group == 1 ? run_files[first] : tmpfile();
+            int failed = !merged || (group > 1 && merge_runs(run_files + first, group, block, merged, 0) != 0);
+            if (merged) for (int r = first; r < first + group; r++) run_files[r] = NULL; // Closed by `merge_runs()` or moved
+            if (failed || (group > 1 && fseek(merged, 0, SEEK_SET) != 0)) {
+                printf(RED "Cannot write temporary run file!\n" RESET);
+                if (merged) fclose(merged);
+                close_runs(run_files, run_count);
+                return 1;
+            }
+            run_files[merged_count++] = merged;
+        }
+        run_count = merged_count;
+        passes++;
+    }
+
+    FILE *out = fopen(output_path, "w");
+    if (!out) {
+        printf(RED "Cannot open output file '%s'!\n" RESET, output_path);
+        close_runs(run_files, run_count);
+        return 1;
+    }
+    setvbuf(out, NULL, _IOFBF, IO_BUFFER_SIZE);
+
+    int failed = merge_runs(run_files, run_count, block, out, 1);
+    free(run_files); // The runs themselves are closed by `merge_runs()`
+    if (fclose(out) != 0 || failed) {
+        printf(RED "Cannot write output file '%s'!\n" RESET, output_path);
+        return 1;
+    }
+    int ways = initial_runs < fan_in ? initial_runs : fan_in;
+    printf("Phase 2: %d-way loser tree merge in %d pass%s -> '%s' (%.2f s)\n", ways, passes, passes == 1 ? "" : "es", output_path, now_seconds() - start);
+    printf(GREEN "✓ Sorted %lld integers within %zu MB\n" RESET, total, memory_bytes >> 20);
+    return 0;
+}
+
+/**
+ * Merges sorted binary runs through a loser tree and closes them (temporary run files are deleted on close).
+ *
+ * @param files     Run files, positioned at their first integer.
+ * @param count     Number of runs (0 writes nothing).
+ * @param block     Size of every run's block buffer in integers.
+ * @param out       Output stream.
+ * @param text      1 to write one integer per line, 0 to write binary ints (a longer run).
+ * @return          0 on success, 1 if out of memory or a write failed.
+ */
+int merge_runs(FILE **files, int count, int block, FILE *out, int text) {
+    if (count == 0) return 0;
+
+    run_reader_t *runs = calloc(count, sizeof(run_reader_t));
+    int *tree = malloc(count * sizeof(int));
+    int *winner = malloc(2 * count * sizeof(int));
+    int ok = runs && tree && winner;
+    for (int r = 0; ok && r < count; r++) {
+        runs[r] = (run_reader_t) {files[r], malloc(block * sizeof(int)), block, 0, 0, 0};
+        ok = runs[r].buffer != NULL;
+    }
+
+    if (ok) {
+        for (int r = 0; r < count; r++) run_reader_advance(&runs[r]);
+
+        // Loser tree: leaf r sits at node k + r, tree[1..k-1] hold the loser of each match and tree[0] the overall winner
+        for (int r = 0; r < count; r++) winner[count + r] = r;
+        for (int node = count - 1; node >= 1; node--) {
+            int a = winner[2 * node], b = winner[2 * node + 1];
+            winner[node] = run_precedes(runs, a, b) ? a : b;
+            tree[node] = run_precedes(runs, a, b) ? b : a;
+        }
+        tree[0] = count > 1 ? winner[1] : 0;
+
+        while (!runs[tree[0]].exhausted) {
+            int w = tree[0];
+            if (text) write_int_text(out, runs[w].buffer[runs[w].position]);
+            else fwrite(&runs[w].buffer[runs[w].position], sizeof(int), 1, out);
+            run_reader_advance(&runs[w]);
+
+            // Replay the matches on the path from the winner's leaf to the root
+            for (int node = (w + count) / 2; node >= 1; node /= 2) {
+                if (run_precedes(runs, tree[node], w)) {
+                    int loser = w;
+                    w = tree[node];
+                    tree[node] = loser;
+                }
+            }
+            tree[0] = w;
+        }
+        ok = fflush(out) == 0 && !ferror(out);
+    }
+
+    for (int r = 0; r < count; r++) {
+        fclose(files[r]);
+        if (runs) free(runs[r].buffer);
+    }
+    free(runs);
+    free(tree);
+    free(winner);
+    return !ok;
+}
+
+/**
+ * Closes every run file that is still open and frees the array holding them.
+ *
+ * @param files     Run files (NULL slots are skipped), or NULL.
+ * @param count     Number of slots.
+ * @return          void
+ */
+void close_runs(FILE **files, int count) {
+    for (int r = 0; files && r < count; r++) if (files[r]) fclose(files[r]);
+    free(files);
+}
+
+/**
+ * Reads up to `capacity` integers from a text reader.
+ *
+ * Like `scanf("%*[^-0-9]%d")`, every character that is not a digit or a minus sign is treated as a
+ * separator; a minus sign only counts when a digit follows it.
+ *
+ * @param in        Text reader of the input file.
+ * @param chunk     Destination buffer.
+ * @param capacity  Maximum number of integers to read.
+ * @return          Number of integers read (0 at end of input).
+ */
+int read_int_chunk(text_reader_t *in, int *chunk, int capacity) {
+    int count = 0;
+    while (count < capacity && text_reader_int(in, &chunk[count])) count++;
+    return count;
+}
+
+/**
+ * Writes one integer followed by a newline.
+ *
+ * @param out       Output stream.
+ * @param value     Integer to write.
+ * @return          void
+ */
+void write_int_text(FILE *out, int value) {
+    char digits[16];
+    int length = 0;
+    unsigned int magnitude = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+
+    digits[15 - length++] = '\n';
+    do {
+        digits[15 - length++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude);
+    if (value < 0) digits[15 - length++] = '-';
+
+    fwrite(digits + 16 - length, 1, length, out);
+}
+
+/**
+ * Moves a run reader to its next integer, refilling its block buffer from the run file when empty.
+ *
+ * @param run       Run reader to advance. `run->buffer[run->position]` is the current integer afterwards.
+ * @return          1 if an integer is available, 0 if the run is exhausted.
+ */
+int run_reader_advance(run_reader_t *run) {
+    if (++run->position < run->count) return 1;
+
+    run->count = (int)fread(run->buffer, sizeof(int), run->capacity, run->file);
+    run->position = 0;
+    run->exhausted = run->count == 0;
+    return !run->exhausted;
+}
+
+/**
+ * Decides a loser tree match: whether run `a`'s current integer is merged before run `b`'s.
+ *
+ * Exhausted runs lose every match; ties go to the lower run index.
+ *
+ * @param runs      Array of run readers.
+ * @param a         Index of the first run.
+ * @param b         Index of the second run.
+ * @return          1 if run `a` wins, 0 otherwise.
+ */
+int run_precedes(run_reader_t *runs, int a, int b) {
+    if (runs[a].exhausted) return 0;
+    if (runs[b].exhausted) return 1;
+    int x = runs[a].buffer[runs[a].position], y = runs[b].buffer[runs[b].position];
+    return x < y || (x == y && a < b);
+}
+
+/**
+ * Sorts every array of a batch file and writes them in the same framing.
+ *
+ * The file holds arrays back to back, each a little-endian `uint32_t` element count followed by the
+ * elements (little-endian 4-byte ints or floats, or 1-byte chars). The whole file is read with one
+ * `fread()`, the arrays are sorted in place by a pool of `threads` workers, and the buffer is written
+ * with one `fwrite()`. Big-endian hosts swap the buffer to host order after reading and back before
+ * writing, like `array_file.h`.
+ *
+ * @param input_path  Batch file to sort.
+ * @param output_path File that receives the sorted arrays.
+ * @param type        Element type ('i', 'f' or 'c').
+ * @param threads     Number of worker threads.
+ * @return            0 on success, 1 on error.
+ */
+int batch_sort_file(const char *input_path, const char *output_path, char type, int threads) {
+    printf(MAGENTA "Batch Merge Sort\n");
+    printf("================\n" RESET);
+    if (type != 'i' && type != 'f' && type != 'c') {
+        printf(RED "Batch mode sorts integers, floats or characters (--type i|f|c)!\n" RESET);
+        return 1;
+    }
+
+    int status = 1;
+    char *data = NULL;
+    size_t *offsets = NULL;
+    FILE *out = NULL;
+    FILE *in = fopen(input_path, "rb");
+    if (!in) {
+        printf(RED "Cannot open input file '%s'!\n" RESET, input_path);
+        goto cleanup;
+    }
+    double start = now_seconds();
+    long length = fseek(in, 0, SEEK_END) == 0 ? ftell(in) : -1;
+    if (length < 0) {
+        printf(RED "Cannot determine the size of input file '%s' (it must be a regular file)!\n" RESET, input_path);
+        goto cleanup;
+    }
+    size_t bytes = (size_t)length;
+    rewind(in);
+    data = malloc(bytes ? bytes : 1);
+    if (!data) {
+        printf(RED "Not enough memory for '%s' (%zu bytes)!\n" RESET, input_path, bytes);
+        goto cleanup;
+    }
+    if (fread(data, 1, bytes, in) != bytes) {
+        printf(RED "Cannot read input file '%s'!\n" RESET, input_path);
+        goto cleanup;
+    }
+    fclose(in);
+    in = NULL;
+
+    if (ARRAY_FILE_SWAP) batch_swap_order(data, bytes, type, 1);
+    int count = index_batch(data, bytes, type, &offsets);
+    if (count < 0) {
+        if (offsets) printf(RED "'%s' is not a batch of length-prefixed arrays (truncated array at byte %zu)!\n" RESET, input_path, offsets[0]);
+        else printf(RED "Not enough memory to index '%s'!\n" RESET, input_path);
+        goto cleanup;
+    }
+    double read_time = now_seconds() - start;
+
+    start = now_seconds();
+    batch_t batch = {data, offsets, count, type, 0};
+    size_t scratch_allocations = sort_batch(&batch, threads);
+    double sort_time = now_seconds() - start;
+
+    start = now_seconds();
+    if (ARRAY_FILE_SWAP) batch_swap_order(data, bytes, type, 0);
+    out = fopen(output_path, "wb");
+    int written = out && fwrite(data, 1, bytes, out) == bytes;
+    if (out && fclose(out) != 0) written = 0;
+    out = NULL;
+    if (!written) {
+        printf(RED "Cannot write output file '%s'!\n" RESET, output_path);
+        goto cleanup;
+    }
+    double write_time = now_seconds() - start;
+
+    printf("Read:  %d arrays, %zu bytes (%.3f s)\n", count, bytes, read_time);
+    printf("Sort:  %d thread%s, %zu scratch allocation%s (%.3f s)\n", threads, threads == 1 ? "" : "s", scratch_allocations, scratch_allocations == 1 ? "" : "s", sort_time);
+    printf("Write: '%s' (%.3f s)\n", output_path, write_time);
+    printf(GREEN "✓ %.0f arrays/s sorted (%.0f arrays/s including I/O)\n" RESET,
+           sort_time > 0 ? count / sort_time : 0.0, read_time + sort_time + write_time > 0 ? count / (read_time + sort_time + write_time) : 0.0);
+    status = 0;
+
+cleanup:
+    if (in) fclose(in);
+    if (out) fclose(out);
+    free(data);
+    free(offsets);
+    return status;
+}
+
+/**
+ * Finds the start of every array in a batch buffer.
+ *
+ * @param data      Batch buffer: per array a `uint32_t` count followed by the elements.
+ * @param bytes     Size of the buffer in bytes.
+ * @param type      Element type ('i', 'f' or 'c').
+ * @param offsets   Receives a malloc'ed array with the byte offset of every array's count. On error it
+ *                      holds a single entry, the offset of the truncated array, or is NULL when out of memory.
+ * @return          Number of arrays, or -1 if the last array runs past the end of the buffer (or out of memory).
+ */
+int index_batch(char *data, size_t bytes, char type, size_t **offsets) {
+    size_t width = element_size(type);
+    int count = 0, capacity = 1024;
+    *offsets = malloc(capacity * sizeof(size_t));
+    if (!*offsets) return -1;
+
+    size_t position = 0;
+    while (position < bytes) {
+        uint32_t length;
+        if (bytes - position < sizeof(uint32_t)) break;
+        memcpy(&length, data + position, sizeof(uint32_t));
+        if ((bytes - position - sizeof(uint32_t)) / width < length) break;
+
+        if (count == capacity) {
+            size_t *grown = realloc(*offsets, (capacity *= 2) * sizeof(size_t));
+            if (!grown) {
+                free(*offsets);
+                *offsets = NULL;
+                return -1;
+            }
+            *offsets = grown;
+        }
+        (*offsets)[count++] = position;
+        position += sizeof(uint32_t) + (size_t)length * width;
+    }
+
+    if (position < bytes) {
+        (*offsets)[0] = position;
+        return -1;
+    }
+    return count;
+}
+
+/**
+ * Reverses the byte order of the counts (and of 4-byte elements) of a batch buffer, converting between
+ * the little-endian file layout and the host order of a big-endian machine. Stops at a truncated array,
+ * which `index_batch()` reports.
+ *
+ * @param data      Batch buffer: per array a `uint32_t` count followed by the elements.
+ * @param bytes     Size of the buffer in bytes.
+ * @param type      Element type ('i', 'f' or 'c').
+ * @param to_host   1 if the counts are in file order (after reading), 0 if in host order (before writing).
+ * @return          void
+ */
+void batch_swap_order(char *data, size_t bytes, char type, int to_host) {
+    size_t width = element_size(type), position = 0;
+    while (bytes - position >= sizeof(uint32_t)) {
+        uint32_t length;
+        memcpy(&length, data + position, sizeof(uint32_t));
+        if (to_host) length = __builtin_bswap32(length);
+        if ((bytes - position - sizeof(uint32_t)) / width < length) break;
+
+        array_file_swap32((uint32_t*)(data + position), 1);
+        if (width == 4) array_file_swap32((uint32_t*)(data + position + sizeof(uint32_t)), length);
+        position += sizeof(uint32_t) + (size_t)length * width;
+    }
+}
+
+/**
+ * Sorts all arrays of a batch in place on a pool of worker threads.
+ *
+ * Workers take `BATCH_GRAB` arrays at a time from a shared atomic counter, so threads that got small
+ * arrays simply take more of them. The calling thread is one of the workers.
+ *
+ * @param batch     Batch to sort (`batch->next` must be 0).
+ * @param threads   Number of worker threads.
+ * @return          Total number of scratch buffer (re)allocations of all workers.
+ */
+size_t sort_batch(batch_t *batch, int threads) {
+    if (threads < 1) threads = 1;
+    pthread_t *ids = malloc(threads * sizeof(pthread_t));
+    int *started = calloc(threads, sizeof(int));
+    batch_worker_t *workers = calloc(threads, sizeof(batch_worker_t));
+
+    for (int t = 0; t < threads; t++) workers[t].batch = batch;
+    for (int t = 1; t < threads; t++) {
+        started[t] = pthread_create(&ids[t], NULL, batch_worker, &workers[t]) == 0;
+        if (!started[t]) batch_worker(&workers[t]); // Without the thread, its share is sorted here
+    }
+    batch_worker(&workers[0]);
+    for (int t = 1; t < threads; t++) if (started[t]) pthread_join(ids[t], NULL);
+
+    size_t allocations = 0;
+    for (int t = 0; t < threads; t++) allocations += workers[t].scratch_allocations;
+    free(ids);
+    free(started);
+    free(workers);
+    return allocations;
+}
+
+/**
+ * pthread entry of a batch worker: sorts arrays until the batch runs out.
+ *
+ * Arrays of up to `SORT_NETWORK_MAX` ints or floats go through a sorting network, all others through
+ * the bottom-up kernels. The worker's scratch buffer only grows when an array larger than every
+ * earlier one comes along, so after the first few arrays there is no heap traffic at all.
+ *
+ * @param arg       Pointer to the worker's `batch_worker_t`.
+ * @return          NULL
+ */
+void *batch_worker(void *arg) {
+    batch_worker_t *worker = arg;
+    batch_t *batch = worker->batch;
+    size_t width = element_size(batch->type);
+    void *scratch = NULL;
+    uint32_t scratch_capacity = 0;
+
+    for (;;) {
+        int first = __atomic_fetch_add(&batch->next, BATCH_GRAB, __ATOMIC_RELAXED);
+        if (first >= batch->count) break;
+        int last = first + BATCH_GRAB < batch->count ? first + BATCH_GRAB : batch->count;
+
+        for (int a = first; a < last; a++) {
+            char *record = batch->data + batch->offsets[a];
+            uint32_t size;
+            memcpy(&size, record, sizeof(uint32_t));
+            void *arr = record + sizeof(uint32_t);
+            if (size < 2 || sort_network(arr, (int)size, batch->type)) continue;
+
+            if (size > scratch_capacity) {
+                scratch_capacity = size;
+                scratch = realloc(scratch, (size_t)size * width);
+                worker->scratch_allocations++;
+            }
+            switch (batch->type) {
+                case 'i': merge_sort_bottom_up_int((int*)arr, (int*)scratch, (int)size, run_length, 0); break;
+                case 'f': merge_sort_bottom_up_float((float*)arr, (float*)scratch, (int)size, run_length, 0); break;
+                case 'c': merge_sort_bottom_up_char((char*)arr, (char*)scratch, (int)size, run_length, 0); break;
+            }
+        }
+    }
+
+    free(scratch);
+    return NULL;
+}
+
+/**
+ * Measures batch throughput in arrays per second for 1, 2, 4, ... threads up to `max_threads`.
+ *
+ * The batch is built in memory with the file framing: `count` integer arrays with random lengths of
+ * 1 to `BATCH_BENCHMARK_MAX_LENGTH` elements. Every run sorts a fresh copy and is checked array by
+ * array against `qsort()`.
+ *
+ * @param count       Number of arrays.
+ * @param max_threads Largest thread count to measure.
+ * @return            void
+ */
+void run_batch_benchmark(int count, int max_threads) {
+    printf(MAGENTA "Batch Merge Sort Benchmark\n");
+    printf("==========================\n" RESET);
+
+    srand(42); // Fixed seed so runs are comparable
+    size_t bytes = 0;
+    uint32_t *lengths = malloc(count * sizeof(uint32_t));
+    for (int a = 0; a < count; a++) {
+        lengths[a] = 1 + rand() % BATCH_BENCHMARK_MAX_LENGTH;
+        bytes += sizeof(uint32_t) + lengths[a] * sizeof(int);
+    }
+    char *input = malloc(bytes), *work = malloc(bytes), *reference = malloc(bytes);
+    for (size_t position = 0, a = 0; position < bytes; position += sizeof(uint32_t) + lengths[a++] * sizeof(int)) {
+        memcpy(input + position, &lengths[a], sizeof(uint32_t));
+        for (uint32_t i = 0; i < lengths[a]; i++) ((int*)(input + position + sizeof(uint32_t)))[i] = rand() - RAND_MAX / 2;
+    }
+    size_t *offsets;
+    index_batch(input, bytes, 'i', &offsets);
+    memcpy(reference, input, bytes);
+    for (int a = 0; a < count; a++) qsort(reference + offsets[a] + sizeof(uint32_t), lengths[a], sizeof(int), compare_int);
+
+    printf("Arrays: %d integer arrays of 1-%d elements (%zu bytes)\n\n", count, BATCH_BENCHMARK_MAX_LENGTH, bytes);
+    printf(BOLD "%8s %12s %14s %10s %8s   %s\n" RESET, "Threads", "Time (s)", "Arrays/s", "Speedup", "Scratch", "vs qsort");
+
+    double single_time = 0;
+    for (int threads = 1; threads <= max_threads; threads = threads * 2 > max_threads && threads < max_threads ? max_threads : threads * 2) {
+        memcpy(work, input, bytes);
+        batch_t batch = {work, offsets, count, 'i', 0};
+        double start = now_seconds();
+        size_t allocations = sort_batch(&batch, threads);
+        double elapsed = now_seconds() - start;
+        if (threads == 1) single_time = elapsed;
+
+        printf("%8d %12.4f %14.0f %9.2fx %8zu   ", threads, elapsed, elapsed > 0 ? count / elapsed : 0.0, elapsed > 0 ? single_time / elapsed : 0.0, allocations);
+        printf(memcmp(work, reference, bytes) == 0 ? GREEN "✓ match" RESET "\n" : RED "✗ MISMATCH" RESET "\n");
+    }
+
+    free(lengths);
+    free(input);
+    free(work);
+    free(reference);
+    free(offsets);
+}
+
+/**
+ * Stably sorts caller-defined records of `record_size` bytes by a key field inside each record.
+ *
+ * The merge passes only move small (key, index) pairs (`merge_sort_record_order()`); the records
+ * themselves are permuted once at the end (`permute_records()`), so a wide payload is copied a fixed
+ * number of times instead of once per merge pass. Records with equal keys keep their original order.
+ *
+ * @param records     Array of `count` records, sorted in place.
+ * @param count       Number of records.
+ * @param record_size Size of one record in bytes (any size, e.g. `sizeof(struct my_record)`).
+ * @param key_offset  Byte offset of the key inside a record (e.g. `offsetof(struct my_record, key)`).
+ * @param key_type    Type of the key field: 'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @return            void
+ */
+void merge_sort_records(void *records, int count, size_t record_size, size_t key_offset, char key_type) {
+    int *order = merge_sort_record_order(records, count, record_size, key_offset, key_type);
+    if (!order) return;
+    permute_records(records, order, count, record_size);
+    free(order);
+}
+
+/**
+ * Computes the stable sorted order of records without moving them.
+ *
+ * Numeric keys are packed with the record index into one `record_key_t` (floats through their bit
+ * pattern, flipped so that unsigned order is numeric order, which puts -0.0 before 0.0), so the
+ * bottom-up kernel merges plain 64-bit integers branch-free. String keys are merged as
+ * (pointer, index) pairs; merge sort keeps equal strings in index order.
+ *
+ * @param records     Array of `count` records.
+ * @param count       Number of records.
+ * @param record_size Size of one record in bytes.
+ * @param key_offset  Byte offset of the key inside a record.
+ * @param key_type    Type of the key field: 'i', 'f', 'c' or 's'.
+ * @return            Newly allocated array where `order[i]` is the index of the record that belongs at
+ *                        position `i` (free it with `free()`), NULL for an unknown key type.
+ */
+int *merge_sort_record_order(const void *records, int count, size_t record_size, size_t key_offset, char key_type) {
+    if (element_size(key_type) == 0) return NULL;
+    int *order = malloc((count > 0 ? count : 1) * sizeof(int));
+    const char *key = (const char*)records + key_offset;
+
+    if (key_type == 's') {
+        record_ref_t *refs = counted_malloc((count > 0 ? count : 1) * sizeof(record_ref_t));
+        record_ref_t *scratch = counted_malloc((count > 0 ? count : 1) * sizeof(record_ref_t));
+        for (int i = 0; i < count; i++, key += record_size) {
+            memcpy(&refs[i].key, key, sizeof(string_t));
+            refs[i].index = i;
+        }
+        merge_sort_bottom_up_record_ref(refs, scratch, count, run_length, 0);
+        for (int i = 0; i < count; i++) order[i] = refs[i].index;
+        free(refs);
+        free(scratch);
+        return order;
+    }
+
+    record_key_t *keys = counted_malloc((count > 0 ? count : 1) * sizeof(record_key_t));
+    record_key_t *scratch = counted_malloc((count > 0 ? count : 1) * sizeof(record_key_t));
+    for (int i = 0; i < count; i++, key += record_size) {
+        uint32_t bits;
+        if (key_type == 'f') {
+            memcpy(&bits, key, sizeof(float));
+            bits ^= bits >> 31 ? 0xffffffffu : 0x80000000u; // Negative floats: reverse their order; positive: above them
+        } else {
+            int value;
+            if (key_type == 'i') memcpy(&value, key, sizeof(int));
+            else value = *key; // char, signed or not as the platform defines it
+            bits = (uint32_t)value ^ 0x80000000u; // Signed -> unsigned order
+        }
+        keys[i] = (record_key_t)bits << 32 | (uint32_t)i;
+    }
+    merge_sort_bottom_up_record_key(keys, scratch, count, run_length, 0);
+    for (int i = 0; i < count; i++) order[i] = (int)(uint32_t)keys[i];
+    free(keys);
+    free(scratch);
+    return order;
+}
+
+/**
+ * Rearranges records into a given order.
+ *
+ * The records are gathered into a scratch copy in their new order and copied back in one sequential
+ * `memcpy()`. If that copy cannot be allocated, the permutation is applied in place by following its
+ * cycles: the first record of a cycle goes to a one-record buffer, every other record is copied
+ * straight into its final slot, and `order` marks finished slots. Gathering is about twice as fast,
+ * since its writes are sequential.
+ *
+ * @param records     Array of `count` records, rearranged in place.
+ * @param order       `order[i]` is the index of the record that belongs at position `i`; may be reset
+ *                        to the identity on return.
+ * @param count       Number of records.
+ * @param record_size Size of one record in bytes.
+ * @return            void
+ */
+void permute_records(void *records, int *order, int count, size_t record_size) {
+    char *base = records;
+    char *gathered = counted_malloc((count > 0 ? count : 1) * record_size);
+    if (gathered) {
+        for (int i = 0; i < count; i++) memcpy(gathered + i * record_size, base + order[i] * record_size, record_size);
+        memcpy(base, gathered, count * record_size);
+        free(gathered);
+        return;
+    }
+
+    char *held = malloc(record_size);
+    for (int start = 0; start < count; start++) {
+        if (order[start] == start) continue;
+
+        memcpy(held, base + start * record_size, record_size);
+        int slot = start;
+        while (order[slot] != start) {
+            int source = order[slot];
+            memcpy(base + slot * record_size, base + source * record_size, record_size);
+            order[slot] = slot;
+            slot = source;
+        }
+        memcpy(base + slot * record_size, held, record_size);
+        order[slot] = slot;
+    }
+    free(held);
+}
+
+/**
+ * Stably sorts records by merging the whole records in every pass, the approach `merge_sort_records()`
+ * avoids. Kept as the baseline for `--record-benchmark`.
+ *
+ * @param records     Array of `count` records, sorted in place.
+ * @param count       Number of records.
+ * @param record_size Size of one record in bytes.
+ * @param key_offset  Byte offset of the key inside a record.
+ * @param key_type    Type of the key field: 'i', 'f', 'c' or 's'.
+ * @return            void
+ */
+void merge_sort_records_direct(void *records, int count, size_t record_size, size_t key_offset, char key_type) {
+    char *src = records, *dst = counted_malloc((count > 0 ? count : 1) * record_size);
+    for (int width = 1; width < count; width *= 2) {
+        for (int left = 0; left < count; left += 2 * width) {
+            int mid = left + width < count ? left + width : count;
+            int right = mid + width < count ? mid + width : count;
+            int i = left, j = mid, k = left;
+            while (i < mid && j < right) {
+                int take_left = record_precedes(src + i * record_size, src + j * record_size, key_offset, key_type);
+                memcpy(dst + k++ * record_size, src + (take_left ? i++ : j++) * record_size, record_size);
+            }
+            memcpy(dst + k * record_size, src + i * record_size, (mid - i) * record_size);
+            k += mid - i;
+            memcpy(dst + k * record_size, src + j * record_size, (right - j) * record_size);
+        }
+        char *temp = src;
+        src = dst;
+        dst = temp;
+    }
+    if (src != records) {
+        memcpy(records, src, count * record_size);
+        dst = src;
+    }
+    free(dst);
+}
+
+/**
+ * Decides whether record `a` stays before record `b` (key of `a` <= key of `b`).
+ *
+ * @param a           First record.
+ * @param b           Second record.
+ * @param key_offset  Byte offset of the key inside a record.
+ * @param key_type    Type of the key field: 'i', 'f', 'c' or 's'.
+ * @return            1 if `a` comes first (ties included), 0 otherwise.
+ */
+int record_precedes(const char *a, const char *b, size_t key_offset, char key_type) {
+    return compare_elements(a + key_offset, b + key_offset, key_type) <= 0;
+}
+
+/**
+ * Benchmarks the record sort on `count` records of an int key followed by a 64-byte payload.
+ *
+ * Keys repeat (`RECORD_BENCHMARK_KEYS` distinct values) and every payload starts with the original
+ * record index, so the check covers order, stability and payload integrity at once. Compares
+ * `merge_sort_records()` with merging whole records (`merge_sort_records_direct()`) and with
+ * `qsort()`, which does not promise stability.
+ *
+ * @param count       Number of records.
+ * @return            void
+ */
+void run_record_benchmark(int count) {
+    printf(MAGENTA "Record Sort Benchmark\n");
+    printf("=====================\n" RESET);
+
+    const size_t record_size = sizeof(int) + RECORD_BENCHMARK_PAYLOAD;
+    size_t bytes = (size_t)count * record_size;
+    char *input = malloc(bytes), *work = malloc(bytes);
+    srand(42); // Fixed seed so runs are comparable
+    for (int i = 0; i < count; i++) {
+        char *record = input + i * record_size;
+        int key = rand() % RECORD_BENCHMARK_KEYS;
+        memcpy(record, &key, sizeof(int));
+        memset(record + sizeof(int), (char)i, RECORD_BENCHMARK_PAYLOAD);
+        memcpy(record + sizeof(int), &i, sizeof(int)); // Payload starts with the original index
+    }
+
+    printf("Records: %d x %zu bytes (int key + %d-byte payload, %d distinct keys)\n\n", count, record_size, RECORD_BENCHMARK_PAYLOAD, RECORD_BENCHMARK_KEYS);
+    printf(BOLD "%-28s %10s %14s   %s\n" RESET, "Sort", "Time (s)", "Records/s", "Check");
+
+    const char *names[3] = {"Key/index + one permutation", "Whole-record merges", "qsort"};
+    for (int method = 0; method < 3; method++) {
+        memcpy(work, input, bytes);
+        double start = now_seconds();
+        if (method == 0) merge_sort_records(work, count, record_size, 0, 'i');
+        else if (method == 1) merge_sort_records_direct(work, count, record_size, 0, 'i');
+        else qsort(work, count, record_size, compare_int);
+        double elapsed = now_seconds() - start;
+
+        // Sorted by key, equal keys in original order, every payload intact
+        int sorted = 1, stable = 1;
+        for (int i = 0; i < count && sorted; i++) {
+            const char *record = work + i * record_size;
+            int key, index;
+            memcpy(&key, record, sizeof(int));
+            memcpy(&index, record + sizeof(int), sizeof(int));
+            const char *original = index >= 0 && index < count ? input + index * record_size : NULL;
+            if (!original || memcmp(record, original, record_size) != 0) sorted = 0;
+            if (i > 0) {
+                int previous_key, previous_index;
+                memcpy(&previous_key, record - record_size, sizeof(int));
+                memcpy(&previous_index, record - record_size + sizeof(int), sizeof(int));
+                if (previous_key > key) sorted = 0;
+                else if (previous_key == key && previous_index > index) stable = 0;
+            }
+        }
+
+        printf("%-28s %10.4f %14.0f   ", names[method], elapsed, elapsed > 0 ? count / elapsed : 0.0);
+        if (!sorted) printf(RED "✗ NOT SORTED" RESET "\n");
+        else if (!stable) printf(YELLOW "sorted, not stable" RESET "\n");
+        else printf(GREEN "✓ sorted, stable" RESET "\n");
+    }
+
+    free(input);
+    free(work);
+}
+
+/**
+ * Benchmarks the integer parsing of the prompts and the external sort: writes `megabytes` MB of
+ * random comma-separated integers (16 per line) to a temporary file, then parses it once with the
+ * text reader (`read()` + SWAR digits) and once with `fscanf("%*[^-0-9]%d")`, the per-element reader
+ * it replaced. Both results are checked against the count and checksum of the generated numbers.
+ *
+ * @param megabytes   Size of the generated input in MB.
+ * @return            void
+ */
+void run_parse_benchmark(int megabytes) {
+    printf(MAGENTA "Integer Parsing Benchmark\n");
+    printf("=========================\n" RESET);
+
+    FILE *file = tmpfile();
+    if (!file) {
+        printf(RED "Cannot create temporary file!\n" RESET);
+        return;
+    }
+    setvbuf(file, NULL, _IOFBF, IO_BUFFER_SIZE);
+
+    // Mixed widths: a third of the numbers have 1-3 digits, the rest up to 10 digits and a sign
+    srand(42); // Fixed seed so runs are comparable
+    size_t target = (size_t)megabytes << 20, bytes = 0;
+    long long count = 0;
+    uint64_t checksum = 0;
+    char text[16];
+    double start = now_seconds();
+    while (bytes < target) {
+        int value = rand() % 3 == 0 ? rand() % 1000 : rand() - RAND_MAX / 2;
+        unsigned int magnitude = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+        int length = 0;
+        do {
+            text[15 - length++] = (char)('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude);
+        if (value < 0) text[15 - length++] = '-';
+        text[15 - length++] = count % 16 == 0 ? '\n' : ','; // Separator first, so `%*[^-0-9]` always has one to skip
+
+        fwrite(text + 16 - length, 1, length, file);
+        bytes += length;
+        checksum += (uint64_t)(int64_t)value;
+        count++;
+    }
+    fflush(file);
+    printf("Input: %lld integers, %.1f MB (generated in %.2f s)\n\n", count, bytes / 1048576.0, now_seconds() - start);
+    printf(BOLD "%-24s %10s %10s %14s   %s\n" RESET, "Parser", "Time (s)", "MB/s", "Integers/s", "Check");
+
+    double reader_time = 0, scanf_time = 0;
+    for (int parser = 0; parser < 2; parser++) {
+        long long parsed = 0;
+        uint64_t sum = 0;
+        int value;
+        start = now_seconds();
+        if (parser == 0) {
+            lseek(fileno(file), 0, SEEK_SET);
+            text_reader_t reader;
+            text_reader_open(&reader, fileno(file));
+            while (text_reader_int(&reader, &value)) {
+                sum += (uint64_t)(int64_t)value;
+                parsed++;
+            }
+            text_reader_close(&reader);
+        } else {
+            rewind(file);
+            while (fscanf(file, "%*[^-0-9]%d", &value) == 1) {
+                sum += (uint64_t)(int64_t)value;
+                parsed++;
+            }
+        }
+        double elapsed = now_seconds() - start;
+        if (parser == 0) reader_time = elapsed;
+        else scanf_time = elapsed;
+
+        printf("%-24s %10.3f %10.0f %14.0f   ", parser == 0 ? "text_reader_int (SWAR)" : "fscanf", elapsed,
+               elapsed > 0 ? bytes / 1048576.0 / elapsed : 0.0, elapsed > 0 ? parsed / elapsed : 0.0);
+        printf(parsed == count && sum == checksum ? GREEN "✓ match" RESET "\n" : RED "✗ MISMATCH" RESET "\n");
+    }
+    if (reader_time > 0) printf("\nText reader speedup: %.1fx\n", scanf_time / reader_time);
+    fclose(file);
+}
+
+/**
+ * Sorts a whole array with the selected strategy.
+ *
+ * @param arr       Pointer to the array to sort.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @param mode      Sort strategy (`MODE_GENERIC`, `MODE_TYPED`, `MODE_SCRATCH`, `MODE_BOTTOM_UP` or `MODE_PARALLEL`).
+ * @param visualize Flag to enable step-by-step visualization. (1 = enable, 0 = disable)
+ *                      Scratch and parallel modes are not visualized and fall back to `MODE_TYPED` when enabled.
+ * @return          void
+ */
+void sort_with_mode(void *arr, int size, char type, sort_mode_t mode, int visualize) {
+    int step = 1;
+    switch (mode) {
+        case MODE_GENERIC: merge_sort_generic(arr, 0, size - 1, type, &step, visualize); break;
+        case MODE_SCRATCH: if (!visualize) { merge_sort_scratch(arr, size, type); break; } // fall through
+        case MODE_PARALLEL: if (!visualize && mode == MODE_PARALLEL) { merge_sort_parallel(arr, size, type, thread_count); break; } // fall through
+        case MODE_TYPED: merge_sort(arr, 0, size - 1, type, &step, visualize); break;
+        case MODE_BOTTOM_UP: merge_sort_bottom_up(arr, size, type, run_length, visualize); break;
+        default: return;
+    }
+}
+
+/**
+ * Sorts an array loaded by `--in --format` with the mode chosen on the command line (never visualized).
+ *
+ * @param arr       Pointer to the array to sort.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @return          void
+ */
+void sort_file_array(void *arr, int size, char type) {
+    sort_with_mode(arr, size, type, sort_mode, 0);
+}
+
+/**
+ * Performs merge sort on an array of various types, deciding the element type inside the merge loop.
+ *
+ * This is the original runtime-`switch` implementation, kept as the baseline for `--benchmark`.
+ * Note that it copies and compares 'i' arrays through `float*`, which misorders negative and
+ * large-magnitude integers, and that it moves strings as whole `char[STRING_LENGTH]` rows with
+ * `strcpy()`. Use `merge_sort()` for actual sorting.
+ *
  * Supported types:
  * - 'i' for int
  * - 'f' for float
@@ -125,7 +1687,7 @@ int main(int argc, char *argv[]) {
  * @param visualize Flag to enable step-by-step visualization. (1 = enable, 0 = disable)
  * @return          void
  */
-void merge_sort(void *arr, int left, int right, char type, int *step, int visualize) {
+void merge_sort_generic(void *arr, int left, int right, char type, int *step, int visualize) {
 
     if (left < right) {
         int mid = left + (right - left) / 2;
@@ -136,8 +1698,8 @@ void merge_sort(void *arr, int left, int right, char type, int *step, int visual
         }
 
         // Recursively sort first and second halves
-        merge_sort(arr, left, mid, type, step, visualize);
-        merge_sort(arr, mid + 1, right, type, step, visualize);
+        merge_sort_generic(arr, left, mid, type, step, visualize);
+        merge_sort_generic(arr, mid + 1, right, type, step, visualize);
 
         // Merge the sorted halves (inline)
         int n1 = mid - left + 1;
@@ -147,24 +1709,24 @@ void merge_sort(void *arr, int left, int right, char type, int *step, int visual
         switch (type) {
             case 'i':
             case 'f':
-                left_arr = malloc(n1 * sizeof(float));
-                right_arr = malloc(n2 * sizeof(float));
+                left_arr = counted_malloc(n1 * sizeof(float));
+                right_arr = counted_malloc(n2 * sizeof(float));
                 for (int i = 0; i < n1; i++)
                     ((float*)left_arr)[i] = ((float*)arr)[left + i];
                 for (int j = 0; j < n2; j++)
                     ((float*)right_arr)[j] = ((float*)arr)[mid + 1 + j];
                 break;
             case 'c':
-                left_arr = malloc(n1 * sizeof(char));
-                right_arr = malloc(n2 * sizeof(char));
+                left_arr = counted_malloc(n1 * sizeof(char));
+                right_arr = counted_malloc(n2 * sizeof(char));
                 for (int i = 0; i < n1; i++)
                     ((char*)left_arr)[i] = ((char*)arr)[left + i];
                 for (int j = 0; j < n2; j++)
                     ((char*)right_arr)[j] = ((char*)arr)[mid + 1 + j];
                 break;
             case 's':
-                left_arr = malloc(n1 * STRING_LENGTH * sizeof(char));
-                right_arr = malloc(n2 * STRING_LENGTH * sizeof(char));
+                left_arr = counted_malloc(n1 * STRING_LENGTH * sizeof(char));
+                right_arr = counted_malloc(n2 * STRING_LENGTH * sizeof(char));
                 for (int i = 0; i < n1; i++)
                     strcpy(((char(*)[STRING_LENGTH])left_arr)[i], ((char(*)[STRING_LENGTH])arr)[left + i]);
                 for (int j = 0; j < n2; j++)
@@ -242,6 +1804,257 @@ void merge_sort(void *arr, int left, int right, char type, int *step, int visual
     }
 }
 
+/**
+ * Benchmarks every sort strategy on the same random input.
+ *
+ * For every supported type a random array is sorted once per `sort_mode_t` (generic runtime `switch`,
+ * typed kernels, single scratch buffer, bottom-up, parallel on `thread_count` threads). Wall-clock time, speedup over the generic
+ * implementation and the number of heap allocations of each run are printed, and every result is
+ * checked against `qsort()` on the same input (integers include negative values).
+ *
+ * Strings are generated as `char[STRING_LENGTH]` rows. The generic implementation sorts the rows
+ * themselves, every other mode sorts an array of pointers to them.
+ *
+ * @param size      Number of random elements to sort per type.
+ * @return          void
+ */
+void run_benchmark(int size) {
+    const char types[] = {'i', 'f', 'c', 's'};
+    const char *names[] = {"Integers", "Floats", "Characters", "Strings"};
+
+    printf(MAGENTA "Merge Sort Benchmark\n");
+    printf("====================\n" RESET);
+    printf("Elements per type: %d (bottom-up run length %d, parallel threads %d)\n", size, run_length, thread_count);
+
+    srand(42); // Fixed seed so runs are comparable
+    for (int t = 0; t < 4; t++) {
+        size_t bytes = size * element_size(types[t]);
+        char *input = malloc(bytes);
+        char *work = malloc(bytes);
+        char *reference = malloc(bytes);
+        char *rows = types[t] == 's' ? malloc((size_t)size * STRING_LENGTH) : NULL;
+        char *row_work = types[t] == 's' ? malloc((size_t)size * STRING_LENGTH) : NULL;
+
+        for (int i = 0; i < size; i++) {
+            switch (types[t]) {
+                case 'i': ((int*)input)[i] = rand() - RAND_MAX / 2; break;
+                case 'f': ((float*)input)[i] = (float)rand() / RAND_MAX * 1000.0f; break;
+                case 'c': ((char*)input)[i] = (char)('a' + rand() % 26); break;
+                case 's': {
+                    int length = 4 + rand() % 12;
+                    char *row = rows + (size_t)i * STRING_LENGTH;
+                    for (int c = 0; c < length; c++) row[c] = (char)('a' + rand() % 26);
+                    row[length] = '\0';
+                    ((string_t*)input)[i] = row;
+                    break;
+                }
+            }
+        }
+
+        memcpy(reference, input, bytes);
+        switch (types[t]) {
+            case 'i': qsort(reference, size, sizeof(int), compare_int); break;
+            case 'f': qsort(reference, size, sizeof(float), compare_float); break;
+            case 'c': qsort(reference, size, sizeof(char), compare_char); break;
+            case 's': qsort(reference, size, sizeof(char*), compare_string); break;
+        }
+
+        printf(BOLD "\n%-12s %12s %10s %14s   %s\n" RESET, names[t], "Time (s)", "Speedup", "Allocations", "vs qsort");
+
+        double generic_time = 0;
+        for (int mode = 0; mode < MODE_COUNT; mode++) {
+            int sort_rows = mode == MODE_GENERIC && types[t] == 's'; // The generic implementation moves whole rows
+            if (sort_rows) memcpy(row_work, rows, (size_t)size * STRING_LENGTH);
+            else memcpy(work, input, bytes);
+
+            allocation_count = 0;
+            double start = now_seconds();
+            sort_with_mode(sort_rows ? row_work : work, size, types[t], (sort_mode_t)mode, 0);
+            double elapsed = now_seconds() - start;
+            if (mode == MODE_GENERIC) generic_time = elapsed;
+
+            int ok = 1;
+            if (sort_rows) {
+                for (int i = 0; i < size && ok; i++) ok = strcmp(row_work + (size_t)i * STRING_LENGTH, ((string_t*)reference)[i]) == 0;
+            } else {
+                ok = matches_reference(work, reference, size, types[t]);
+            }
+
+            printf("  %-10s %12.4f %9.2fx %14zu   ", mode_names[mode], elapsed, elapsed > 0 ? generic_time / elapsed : 0.0, allocation_count);
+            printf(ok ? GREEN "✓ match" RESET "\n" : RED "✗ MISMATCH" RESET "\n");
+        }
+
+        free(input);
+        free(work);
+        free(reference);
+        free(rows);
+        free(row_work);
+    }
+}
+
+/**
+ * Measures how the parallel merge sort scales with the number of threads.
+ *
+ * The same random integer array is sorted with 1, 2, 4, ... threads up to `max_threads` (which is
+ * always included). Each run prints its time, speedup over one thread and parallel efficiency.
+ *
+ * @param size        Number of random integers to sort.
+ * @param max_threads Largest thread count to measure.
+ * @return            void
+ */
+void run_scaling_benchmark(int size, int max_threads) {
+    printf(MAGENTA "Merge Sort Scaling Benchmark\n");
+    printf("============================\n" RESET);
+    printf("Random integers: %d\n\n", size);
+    printf(BOLD "%8s %12s %10s %12s   %s\n" RESET, "Threads", "Time (s)", "Speedup", "Efficiency", "vs qsort");
+
+    int *input = malloc(size * sizeof(int));
+    int *work = malloc(size * sizeof(int));
+    int *reference = malloc(size * sizeof(int));
+
+    srand(42); // Fixed seed so runs are comparable
+    for (int i = 0; i < size; i++) input[i] = rand() - RAND_MAX / 2;
+    memcpy(reference, input, size * sizeof(int));
+    qsort(reference, size, sizeof(int), compare_int);
+
+    double single_time = 0;
+    for (int threads = 1; threads <= max_threads; threads = threads * 2 > max_threads && threads < max_threads ? max_threads : threads * 2) {
+        memcpy(work, input, size * sizeof(int));
+        double start = now_seconds();
+        merge_sort_parallel(work, size, 'i', threads);
+        double elapsed = now_seconds() - start;
+        if (threads == 1) single_time = elapsed;
+
+        double speedup = elapsed > 0 ? single_time / elapsed : 0.0;
+        printf("%8d %12.4f %9.2fx %11.0f%%   ", threads, elapsed, speedup, speedup / threads * 100.0);
+        printf(matches_reference(work, reference, size, 'i') ? GREEN "✓ match" RESET "\n" : RED "✗ MISMATCH" RESET "\n");
+    }
+
+    free(input);
+    free(work);
+    free(reference);
+}
+
+/**
+ * Checks that a sorted array holds the same values, in the same order, as a reference array.
+ *
+ * @param arr       Pointer to the array to check.
+ * @param reference Pointer to the reference (e.g. `qsort()`-sorted) array.
+ * @param size      Number of elements in both arrays.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @return          1 if every element compares equal, 0 otherwise.
+ */
+int matches_reference(void *arr, void *reference, int size, char type) {
+    size_t width = element_size(type);
+    for (int i = 0; i < size; i++)
+        if (compare_elements((char*)arr + i * width, (char*)reference + i * width, type) != 0) return 0;
+    return 1;
+}
+
+/**
+ * Compares two elements of the given type, `qsort()` style.
+ *
+ * @param a         Pointer to the first element.
+ * @param b         Pointer to the second element.
+ * @param type      Data type of the elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @return          Negative if a < b, 0 if equal, positive if a > b.
+ */
+int compare_elements(const void *a, const void *b, char type) {
+    switch (type) {
+        case 'i': return compare_int(a, b);
+        case 'f': return compare_float(a, b);
+        case 'c': return compare_char(a, b);
+        case 's': return compare_string(a, b);
+        default: return 0;
+    }
+}
+
+// `qsort()` comparators for each element type
+int compare_int(const void *a, const void *b) { return (*(const int*)a > *(const int*)b) - (*(const int*)a < *(const int*)b); }
+int compare_float(const void *a, const void *b) { return (*(const float*)a > *(const float*)b) - (*(const float*)a < *(const float*)b); }
+int compare_char(const void *a, const void *b) { return (*(const char*)a > *(const char*)b) - (*(const char*)a < *(const char*)b); }
+int compare_string(const void *a, const void *b) { return strcmp(*(char * const*)a, *(char * const*)b); }
+
+/**
+ * Allocates memory and records the allocation in `allocation_count` and `allocation_bytes`.
+ *
+ * @param bytes     Number of bytes to allocate.
+ * @return          Pointer to the allocated memory (as returned by `malloc()`).
+ */
+void *counted_malloc(size_t bytes) {
+    allocation_count++;
+    allocation_bytes += bytes;
+    return malloc(bytes);
+}
+
+/**
+ * Returns the size in bytes of one element of the given type.
+ *
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @return          Element size in bytes, 0 for unknown type.
+ */
+size_t element_size(char type) {
+    switch (type) {
+        case 'i': return sizeof(int);
+        case 'f': return sizeof(float);
+        case 'c': return sizeof(char);
+        case 's': return sizeof(string_t);
+        default: return 0;
+    }
+}
+
+/**
+ * Returns a monotonic timestamp in seconds, used for benchmark timing.
+ *
+ * @return          Current monotonic time in seconds.
+ */
+double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Reads whitespace-separated strings of any length from standard input into one arena.
+ *
+ * All characters are appended back to back (each string NUL-terminated) to a single growing buffer,
+ * and the returned array holds one pointer per string into it. Sorting then only moves pointers.
+ * The character that ends the last string is pushed back, so the caller can still clear the line.
+ *
+ * @param size      Number of strings to read.
+ * @param arena     Receives the arena holding the characters. Free it after the pointer array.
+ * @return          Array of `size` pointers into the arena.
+ */
+string_t *read_strings(int size, char **arena) {
+    size_t capacity = 256, used = 0;
+    size_t *offsets = malloc(size * sizeof(size_t)); // Offsets, because the arena may move while growing
+    *arena = malloc(capacity);
+
+    int c = EOF;
+    for (int i = 0; i < size; i++) {
+        c = getchar();
+        while (c != EOF && isspace(c)) c = getchar();
+
+        offsets[i] = used;
+        while (1) {
+            if (used + 1 >= capacity) *arena = realloc(*arena, capacity *= 2);
+            if (c == EOF || isspace(c)) break;
+            (*arena)[used++] = (char)c;
+            c = getchar();
+        }
+        (*arena)[used++] = '\0';
+    }
+    if (c != EOF) ungetc(c, stdin);
+
+    string_t *strings = malloc(size * sizeof(string_t));
+    for (int i = 0; i < size; i++) strings[i] = *arena + offsets[i];
+    free(offsets);
+    return strings;
+}
+
 /**
  * Prints an array of various types without highlighting.
  *
@@ -249,12 +2062,12 @@ void merge_sort(void *arr, int left, int right, char type, int *step, int visual
  * - 'i' for int
  * - 'f' for float
  * - 'c' for char
- * - 's' for string (char[STRING_LENGTH]) - `STRING_LENGTH` is defined as 50.
+ * - 's' for string (char*) - pointers into one string arena, strings of any length.
  *
  * @param arr       Pointer to the array to print.
  * @param size      Number of elements in the array.
  * @param type      Data type of the array elements:
- *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char[STRING_LENGTH]).
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
  * @return          void
  */
 void print_array(void *arr, int size, char type) {
@@ -268,12 +2081,12 @@ void print_array(void *arr, int size, char type) {
  * - 'i' for int
  * - 'f' for float
  * - 'c' for char
- * - 's' for string (char[STRING_LENGTH]) - `STRING_LENGTH` is defined as 50.
+ * - 's' for string (char*) - pointers into one string arena, strings of any length.
  *
  * @param arr       Pointer to the array to print.
  * @param size      Number of elements in the array.
  * @param type      Data type of the array elements:
- *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char[STRING_LENGTH]).
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
  * @param left      Left index of the range to highlight. (optional, -1 for no highlight)
  * @param right     Right index of the range to highlight. (optional, -1 for no highlight)
  * @param mid       Index of the mid-point to highlight. (optional, -1 for no highlight)
@@ -297,7 +2110,7 @@ void print_array_with_range(void *arr, int size, char type, int left, int right,
                 printf("'%c'", ((char *)arr)[i]);
                 break;
             case 's':
-                printf("\"%s\"", ((char (*)[STRING_LENGTH])arr)[i]);
+                printf("\"%s\"", ((string_t*)arr)[i]);
                 break;
             default:
                 printf("Unknown type");
@@ -0,0 +1,696 @@
+//
+// Created by Dany on 10/17/2026.
+// Copyright (c) 2026 DanyilT. All rights reserved.
+// MIT License: https://github.com/DanyilT/C/blob/main/LICENSE
+// This file is part of 'DanyilT/C' repo: https://github.com/DanyilT/C
+//
+// Quick Sort (Introsort) Implementation in C
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <ctype.h>
+#include <stdint.h>
+#include <time.h>
+#include "ansi_colors.h" // Include ANSI color codes for console output (custom header file)
+#include "array_file.h" // Binary and line-delimited array files for `--in` / `--out` (custom header file)
+#include "text_reader.h" // Buffered `read()` input with a SWAR number parser for the prompts (custom header file)
+#include "sorting_network.h" // Sorting networks for int and float arrays of up to 16 elements (custom header file)
+
+#define INSERTION_CUTOFF 16   // Partitions of this many elements or fewer are finished by a sorting network (ints, floats) or insertion sort
+#define NINTHER_THRESHOLD 128 // Partitions larger than this pick the pivot as a median of three medians (ninther)
+#define NETWORK_BENCHMARK_SIZE 8 // Elements per array in `--network-benchmark`
+#define NETWORK_BENCHMARK_POOL (1 << 20) // Arrays kept in memory by `--network-benchmark`, reused until the count is reached
+
+#if INSERTION_CUTOFF > SORT_NETWORK_MAX
+#error "INSERTION_CUTOFF must not exceed SORT_NETWORK_MAX, the small ranges of ints and floats go to the sorting network"
+#endif
+
+// String element: pointer to a NUL-terminated string of any length in the string arena (sorting moves only pointers)
+typedef char *string_t;
+
+void quick_sort(void *arr, int size, char type, int visualize);
+void sort_file_array(void *arr, int size, char type);
+void quick_sort_int(int *arr, int left, int right, int depth_limit, int *step, int visualize);
+void quick_sort_float(float *arr, int left, int right, int depth_limit, int *step, int visualize);
+void quick_sort_char(char *arr, int left, int right, int depth_limit, int *step, int visualize);
+void quick_sort_string(string_t *arr, int left, int right, int depth_limit, int *step, int visualize);
+int depth_limit_for(int size);
+void merge_sort_reference(int *arr, int size);
+int compare_int(const void *a, const void *b);
+int compare_float(const void *a, const void *b);
+void run_benchmark(int size);
+void run_network_benchmark(int count);
+double now_seconds(void);
+string_t *read_strings(int size, char **arena);
+void print_array(void *arr, int size, char type);
+void print_array_with_range(void *arr, int size, char type, int left, int right, int mid);
+
+int main(int argc, char *argv[]) {
+    int visualize = 0;
+    int benchmark_size = 0;
+    int network_count = 0;
+    const char *input_path = NULL, *output_path = NULL, *format = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0 || strcmp(argv[i], "--visualize") == 0) visualize = 1; // Enable visualization if -v or --visualize is passed
+        else if (strcmp(argv[i], "--benchmark") == 0 && i + 1 < argc) benchmark_size = atoi(argv[++i]); // Compare with merge sort on N integers per input pattern
+        else if (strcmp(argv[i], "--network-benchmark") == 0) network_count = i + 1 < argc && atoi(argv[i + 1]) > 0 ? atoi(argv[++i]) : 10000000; // Sort N tiny arrays (default: 10M)
+        else if (strcmp(argv[i], "--in") == 0 && i + 1 < argc) input_path = argv[++i]; // Sort an array file instead of prompting (needs --format)
+        else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) output_path = argv[++i]; // Output file of --in (default: stdout)
+        else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) format = argv[++i]; // Array file format: i32, f32, u8 or lines
+    }
+
+    if (input_path) return sort_array_file(input_path, output_path, format, sort_file_array);
+
+    if (benchmark_size > 0) {
+        run_benchmark(benchmark_size);
+        return 0;
+    }
+    if (network_count > 0) {
+        run_network_benchmark(network_count);
+        return 0;
+    }
+
+    setvbuf(stdin, NULL, _IONBF, 0); // The number prompts read stdin with `read()` (text_reader.h), so stdio must not read ahead
+    int choice;
+    printf(MAGENTA "Quick Sort\n");
+    printf("==========\n" RESET);
+    if (visualize) printf(BG_YELLOW "Visualization enabled." RESET "\n");
+    printf("Choose data type:\n");
+    printf("1. Integers\n");
+    printf("2. Floats\n");
+    printf("3. Characters\n");
+    printf("4. Strings\n");
+    printf("Enter your choice (1-4): ");
+    scanf("%d", &choice);
+
+    int size;
+    printf("Enter array size: ");
+    scanf("%d", &size);
+
+    char type = 0;
+    void *arr = NULL;
+    char *arena = NULL; // Backing storage of the strings when sorting 's' (`arr` then holds pointers into it)
+
+    switch(choice) {
+        // For integers
+        case 1: {
+            type = 'i';
+            arr = malloc(size * sizeof(int));
+
+            text_reader_t reader;
+            text_reader_open(&reader, STDIN_FILENO);
+            printf("Enter %d integers: ", size);
+            for (int i = 0; i < size; i++) text_reader_int(&reader, &((int*)arr)[i]);
+            text_reader_skip_line(&reader); // Clear input buffer
+            text_reader_close(&reader);
+            break;
+        }
+        // For floats
+        case 2: {
+            type = 'f';
+            arr = malloc(size * sizeof(float));
+
+            text_reader_t reader;
+            text_reader_open(&reader, STDIN_FILENO);
+            printf("Enter %d floats: ", size);
+            for (int i = 0; i < size; i++) text_reader_float(&reader, &((float*)arr)[i]);
+            text_reader_skip_line(&reader); // Clear input buffer
+            text_reader_close(&reader);
+            break;
+        }
+        // For characters
+        case 3: {
+            type = 'c';
+            arr = malloc(size * sizeof(char));
+
+            printf("Enter %d characters: ", size);
+            for (int i = 0; i < size; i++) scanf(" %c", &((char*)arr)[i]);
+            while (getchar() != '\n'); // Clear input buffer
+            break;
+        }
+        // For strings
+        case 4: {
+            type = 's';
+
+            printf("Enter %d strings: ", size);
+            arr = read_strings(size, &arena);
+            while (getchar() != '\n'); // Clear input buffer
+            break;
+        }
+        // Invalid choice
+        default:
+            printf(RED "Invalid choice!\n" RESET);
+            return 1;
+    }
+
+    printf(CYAN "\n-- Quick Sort --\n" RESET);
+
+    printf(YELLOW "\n-- Original Array\n" RESET DIM);
+    print_array(arr, size, type);
+    printf(RESET);
+
+    printf(DIM "Sorting...\n" RESET);
+    quick_sort(arr, size, type, visualize);
+
+    printf(GREEN "\n-- Sorted Array\n" RESET BOLD);
+    print_array(arr, size, type);
+    printf(RESET);
+
+    free(arr);
+    free(arena);
+    return 0;
+}
+
+/**
+ * Sorts an array loaded by `--in` (never visualized).
+ *
+ * @param arr       Pointer to the array to sort.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @return          void
+ */
+void sort_file_array(void *arr, int size, char type) {
+    quick_sort(arr, size, type, 0);
+}
+
+/**
+ * Performs introsort (quick sort with a heapsort fallback) on an array of various types.
+ *
+ * The element type is resolved once here and the call is dispatched to a type-specialized kernel.
+ * The kernels partition around a median-of-three (or ninther) pivot, switch to heapsort when the
+ * recursion gets deeper than `2 * log2(size)` and finish small partitions with a sorting network
+ * (ints, floats) or insertion sort, so the sort is in place and O(n log n) in the worst case.
+ * Int and float arrays of up to `SORT_NETWORK_MAX` elements go to the sorting network directly.
+ *
+ * Supported types:
+ * - 'i' for int
+ * - 'f' for float
+ * - 'c' for char
+ * - 's' for string (char*) - pointers into one string arena, strings of any length.
+ *
+ * @param arr       Pointer to the array to sort.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @param visualize Flag to enable step-by-step visualization. (1 = enable, 0 = disable)
+ * @return          void
+ */
+void quick_sort(void *arr, int size, char type, int visualize) {
+    if (size < 2) return;
+    if (!visualize && sort_network(arr, size, type)) return; // Up to 16 ints or floats: no partitioning at all
+    if (visualize) printf(BOLD "\nStep-by-step sorting:\n" RESET);
+
+    int step = 1;
+    int depth_limit = depth_limit_for(size);
+    switch (type) {
+        case 'i': quick_sort_int((int*)arr, 0, size - 1, depth_limit, &step, visualize); break;
+        case 'f': quick_sort_float((float*)arr, 0, size - 1, depth_limit, &step, visualize); break;
+        case 'c': quick_sort_char((char*)arr, 0, size - 1, depth_limit, &step, visualize); break;
+        case 's': quick_sort_string((string_t*)arr, 0, size - 1, depth_limit, &step, visualize); break;
+        default: return; // Unsupported type
+    }
+}
+
+/**
+ * Returns the number of partitioning levels allowed before falling back to heapsort: `2 * floor(log2(size))`.
+ *
+ * @param size      Number of elements to sort.
+ * @return          Maximum partitioning depth.
+ */
+int depth_limit_for(int size) {
+    int depth = 0;
+    while (size > 1) {
+        size >>= 1;
+        depth++;
+    }
+    return 2 * depth;
+}
+
+// Element comparison used by the kernels: `less(a, b)` is true when `a` must come before `b`
+#define NUMBER_LESS(a, b) ((a) < (b))
+#define STRING_LESS(a, b) (strcmp((a), (b)) < 0)
+
+// Sort of the range left over below the cutoff: `small_sort(name, arr, left, right)`
+#define SMALL_SORT_INSERTION(name, arr, left, right) name##_insertion((arr), (left), (right))
+#define SMALL_SORT_NETWORK_INT(name, arr, left, right) sort_network_int((arr) + (left), (right) - (left) + 1)
+#define SMALL_SORT_NETWORK_FLOAT(name, arr, left, right) sort_network_float((arr) + (left), (right) - (left) + 1)
+
+/**
+ * Defines an introsort kernel specialized for one element type.
+ *
+ * The generated function sorts `arr[left..right]` and comes with three helpers:
+ * - `name##_median3()`: index of the median of three elements
+ * - `name##_insertion()`: insertion sort of a small range
+ * - `name##_heapsort()`: heapsort of a range, used when `depth_limit` runs out (adversarial input)
+ *
+ * The partition is Hoare-style around the pivot moved to `arr[left]`: both scans stop on elements
+ * equal to the pivot, so inputs with few unique values still split in the middle. The smaller side is
+ * sorted recursively and the larger one in a loop, which keeps the stack at O(log n).
+ *
+ * @param name      Name of the generated function.
+ * @param T         Element type.
+ * @param type_code Type code passed to the print helpers for visualization ('i', 'f', 'c', 's').
+ * @param less      Comparison macro `less(a, b)`, true when `a` must come before `b`.
+ * @param small_sort Sort of ranges up to `INSERTION_CUTOFF` elements, `SMALL_SORT_INSERTION` or a `SMALL_SORT_NETWORK_*`.
+ */
+#define DEFINE_QUICK_SORT_KERNEL(name, T, type_code, less, small_sort)                                                          \
+int name##_median3(T *arr, int a, int b, int c) {                                                                               \
+    if (less(arr[a], arr[b])) return less(arr[b], arr[c]) ? b : (less(arr[a], arr[c]) ? c : a);                                 \
+    return less(arr[a], arr[c]) ? a : (less(arr[b], arr[c]) ? c : b);                                                           \
+}                                                                                                                               \
+                                                                                                                                \
+void name##_insertion(T *arr, int left, int right) {                                                                            \
+    for (int i = left + 1; i <= right; i++) {                                                                                   \
+        T key = arr[i];                                                                                                         \
+        int j = i - 1;                                                                                                          \
+        while (j >= left && less(key, arr[j])) {                                                                                \
+            arr[j + 1] = arr[j];                                                                                                \
+            j--;                                                                                                                \
+        }                                                                                                                       \
+        arr[j + 1] = key;                                                                                                       \
+    }                                                                                                                           \
+}                                                                                                                               \
+                                                                                                                                \
+void name##_heapsort(T *arr, int left, int right) {                                                                             \
+    T *base = arr + left;                                                                                                       \
+    int n = right - left + 1;                                                                                                   \
+    for (int start = n / 2 - 1, end = n; end > 1; ) {                                                                           \
+        /* Build the max-heap first (start >= 0), then move the maximum behind the heap */                                      \
+        int root;                                                                                                               \
+        if (start >= 0) root = start--;                                                                                         \
+        else {                                                                                                                  \
+            end--;                                                                                                              \
+            T temp = base[0]; base[0] = base[end]; base[end] = temp;                                                            \
+            root = 0;                                                                                                           \
+        }                                                                                                                       \
+        /* Sift `root` down within base[0..end) */                                                                              \
+        T value = base[root];                                                                                                   \
+        int child;                                                                                                              \
+        while ((child = 2 * root + 1) < end) {                                                                                  \
+            if (child + 1 < end && less(base[child], base[child + 1])) child++;                                                 \
+            if (!less(value, base[child])) break;                                                                               \
+            base[root] = base[child];                                                                                           \
+            root = child;                                                                                                       \
+        }                                                                                                                       \
+        base[root] = value;                                                                                                     \
+    }                                                                                                                           \
+}                                                                                                                               \
+                                                                                                                                \
+void name(T *arr, int left, int right, int depth_limit, int *step, int visualize) {                                             \
+    /* Visualization shows every partition, down to two elements */                                                             \
+    int cutoff = visualize ? 1 : INSERTION_CUTOFF;                                                                              \
+    while (right - left + 1 > cutoff) {                                                                                         \
+        if (depth_limit-- == 0) {                                                                                               \
+            name##_heapsort(arr, left, right);                                                                                  \
+            if (visualize) {                                                                                                    \
+                printf(RED "Step %d: Depth limit reached, heapsort [%d-%d] -> " RESET, (*step)++, left, right);                 \
+                print_array_with_range(arr, right + 1, type_code, left, right, -1);                                             \
+            }                                                                                                                   \
+            return;                                                                                                             \
+        }                                                                                                                       \
+                                                                                                                                \
+        /* Pattern check: an ascending range is done, a strictly descending one only needs reversing.  */                       \
+        /* The scans stop at the first element out of pattern, so they cost almost nothing otherwise   */                       \
+        int k = left;                                                                                                           \
+        while (k < right && !less(arr[k + 1], arr[k])) k++;                                                                     \
+        if (k == right) {                                                                                                       \
+            if (visualize) {                                                                                                    \
+                printf(GREEN "Step %d: [%d-%d] already sorted -> " RESET, (*step)++, left, right);                              \
+                print_array_with_range(arr, right + 1, type_code, left, right, -1);                                             \
+            }                                                                                                                   \
+            return;                                                                                                             \
+        }                                                                                                                       \
+        if (k == left) {                                                                                                        \
+            while (k < right && less(arr[k + 1], arr[k])) k++;                                                                  \
+            if (k == right) {                                                                                                   \
+                for (int lo = left, hi = right; lo < hi; lo++, hi--) {                                                          \
+                    T temp = arr[lo]; arr[lo] = arr[hi]; arr[hi] = temp;                                                        \
+                }                                                                                                               \
+                if (visualize) {                                                                                                \
+                    printf(GREEN "Step %d: [%d-%d] strictly descending, reversed -> " RESET, (*step)++, left, right);           \
+                    print_array_with_range(arr, right + 1, type_code, left, right, -1);                                         \
+                }                                                                                                               \
+                return;                                                                                                         \
+            }                                                                                                                   \
+        }                                                                                                                       \
+                                                                                                                                \
+        /* Pivot: median of three, or of three medians of three for large partitions */                                         \
+        int mid = left + (right - left) / 2;                                                                                    \
+        int pivot_index;                                                                                                        \
+        if (right - left + 1 > NINTHER_THRESHOLD) {                                                                             \
+            int eighth = (right - left + 1) / 8;                                                                                \
+            pivot_index = name##_median3(arr,                                                                                   \
+                name##_median3(arr, left, left + eighth, left + 2 * eighth),                                                    \
+                name##_median3(arr, mid - eighth, mid, mid + eighth),                                                           \
+                name##_median3(arr, right - 2 * eighth, right - eighth, right));                                                \
+        } else {                                                                                                                \
+            pivot_index = name##_median3(arr, left, mid, right);                                                                \
+        }                                                                                                                       \
+        T temp = arr[left]; arr[left] = arr[pivot_index]; arr[pivot_index] = temp;                                              \
+        T pivot = arr[left];                                                                                                    \
+                                                                                                                                \
+        /* Hoare partition: arr[left+1..j] <= pivot, arr[j+1..right] >= pivot */                                                \
+        int i = left, j = right + 1;                                                                                            \
+        while (1) {                                                                                                             \
+            while (less(arr[++i], pivot)) if (i == right) break;                                                                \
+            while (less(pivot, arr[--j])) ;                                                                                     \
+            if (i >= j) break;                                                                                                  \
+            temp = arr[i]; arr[i] = arr[j]; arr[j] = temp;                                                                      \
+        }                                                                                                                       \
+        temp = arr[left]; arr[left] = arr[j]; arr[j] = temp;                                                                    \
+                                                                                                                                \
+        if (visualize) {                                                                                                        \
+            printf(CYAN "Step %d: Partitioned [%d-%d] around pivot at %d -> " RESET, (*step)++, left, right, j);                \
+            print_array_with_range(arr, right + 1, type_code, left, right, j);                                                  \
+        }                                                                                                                       \
+                                                                                                                                \
+        /* Recurse into the smaller side, loop on the larger one */                                                             \
+        if (j - left < right - j) {                                                                                             \
+            name(arr, left, j - 1, depth_limit, step, visualize);                                                               \
+            left = j + 1;                                                                                                       \
+        } else {                                                                                                                \
+            name(arr, j + 1, right, depth_limit, step, visualize);                                                              \
+            right = j - 1;                                                                                                      \
+        }                                                                                                                       \
+    }                                                                                                                           \
+    if (right > left) {                                                                                                         \
+        small_sort(name, arr, left, right);                                                                                     \
+        if (visualize) {                                                                                                        \
+            printf(BLUE "Step %d: Small sort [%d-%d] -> " RESET, (*step)++, left, right);                                       \
+            print_array_with_range(arr, right + 1, type_code, left, right, -1);                                                 \
+        }                                                                                                                       \
+    }                                                                                                                           \
+}
+
+DEFINE_QUICK_SORT_KERNEL(quick_sort_int, int, 'i', NUMBER_LESS, SMALL_SORT_NETWORK_INT)
+DEFINE_QUICK_SORT_KERNEL(quick_sort_float, float, 'f', NUMBER_LESS, SMALL_SORT_NETWORK_FLOAT)
+DEFINE_QUICK_SORT_KERNEL(quick_sort_char, char, 'c', NUMBER_LESS, SMALL_SORT_INSERTION)
+DEFINE_QUICK_SORT_KERNEL(quick_sort_string, string_t, 's', STRING_LESS, SMALL_SORT_INSERTION)
+
+/**
+ * Sorts integers with a bottom-up merge sort (one scratch buffer), the comparison point of `--benchmark`.
+ *
+ * This mirrors `merge_sort --bottom-up` from `sorting/merge_sort` without the insertion-sorted runs.
+ *
+ * @param arr       Array of integers to sort.
+ * @param size      Number of elements in the array.
+ * @return          void
+ */
+void merge_sort_reference(int *arr, int size) {
+    int *scratch = malloc(size * sizeof(int));
+    int *src = arr, *dst = scratch;
+    for (int width = 1; width < size; width *= 2) {
+        for (int left = 0; left < size; left += 2 * width) {
+            int mid = left + width < size ? left + width : size;
+            int right = mid + width < size ? mid + width : size;
+            int i = left, j = mid, k = left;
+            while (i < mid && j < right) dst[k++] = src[i] <= src[j] ? src[i++] : src[j++];
+            while (i < mid) dst[k++] = src[i++];
+            while (j < right) dst[k++] = src[j++];
+        }
+        int *temp = src;
+        src = dst;
+        dst = temp;
+    }
+    if (src != arr) memcpy(arr, src, size * sizeof(int));
+    free(scratch);
+}
+
+// `qsort()` comparators used to check the benchmark results
+int compare_int(const void *a, const void *b) { return (*(const int*)a > *(const int*)b) - (*(const int*)a < *(const int*)b); }
+int compare_float(const void *a, const void *b) { return (*(const float*)a > *(const float*)b) - (*(const float*)a < *(const float*)b); }
+
+/**
+ * Benchmarks quick sort against merge sort on sorted, reversed, random and few-unique integer inputs.
+ *
+ * Both sorts get a copy of the same input and every result is compared with `qsort()`.
+ *
+ * @param size      Number of integers per input pattern.
+ * @return          void
+ */
+void run_benchmark(int size) {
+    const char *patterns[] = {"Sorted", "Reversed", "Random", "Few unique"};
+
+    printf(MAGENTA "Quick Sort Benchmark\n");
+    printf("====================\n" RESET);
+    printf("Integers per input: %d\n\n", size);
+    printf(BOLD "%-12s %14s %14s %10s   %s\n" RESET, "Input", "Merge sort (s)", "Quick sort (s)", "Speedup", "vs qsort");
+
+    int *input = malloc(size * sizeof(int));
+    int *quick = malloc(size * sizeof(int));
+    int *merge = malloc(size * sizeof(int));
+    int *reference = malloc(size * sizeof(int));
+
+    srand(42); // Fixed seed so runs are comparable
+    for (int p = 0; p < 4; p++) {
+        for (int i = 0; i < size; i++) {
+            switch (p) {
+                case 0: input[i] = i; break;
+                case 1: input[i] = size - i; break;
+                case 2: input[i] = rand() - RAND_MAX / 2; break;
+                case 3: input[i] = rand() % 8; break;
+            }
+        }
+        memcpy(quick, input, size * sizeof(int));
+        memcpy(merge, input, size * sizeof(int));
+        memcpy(reference, input, size * sizeof(int));
+        qsort(reference, size, sizeof(int), compare_int);
+
+        double start = now_seconds();
+        merge_sort_reference(merge, size);
+        double merge_time = now_seconds() - start;
+
+        start = now_seconds();
+        quick_sort(quick, size, 'i', 0);
+        double quick_time = now_seconds() - start;
+
+        int ok = memcmp(quick, reference, size * sizeof(int)) == 0 && memcmp(merge, reference, size * sizeof(int)) == 0;
+        printf("%-12s %14.4f %14.4f %9.2fx   ", patterns[p], merge_time, quick_time, quick_time > 0 ? merge_time / quick_time : 0.0);
+        printf(ok ? GREEN "✓ match" RESET "\n" : RED "✗ MISMATCH" RESET "\n");
+    }
+
+    free(input);
+    free(quick);
+    free(merge);
+    free(reference);
+}
+
+/**
+ * Benchmarks sorts of many tiny arrays: `count` separate arrays of `NETWORK_BENCHMARK_SIZE` random ints
+ * and floats each, sorted one by one.
+ *
+ * Methods are the sorting network, the kernels' insertion sort (what small partitions used before),
+ * `quick_sort()` (the public entry point), `merge_sort_reference()` (one malloc per array, ints only)
+ * and `qsort()`. Up to `NETWORK_BENCHMARK_POOL` arrays are generated and copied again for every round
+ * until `count` arrays are sorted; the last round is compared with `qsort()`.
+ *
+ * @param count     Number of arrays to sort per method.
+ * @return          void
+ */
+void run_network_benchmark(int count) {
+    const char types[] = {'i', 'f'};
+    const char *names[] = {"Integers", "Floats"};
+    const char *methods[] = {"Sorting network", "Insertion sort", "quick_sort()", "Merge sort", "qsort()"};
+    const int n = NETWORK_BENCHMARK_SIZE;
+    int pool = count < NETWORK_BENCHMARK_POOL ? count : NETWORK_BENCHMARK_POOL;
+    size_t pool_bytes = (size_t)pool * n * sizeof(int);
+
+    printf(MAGENTA "Sorting Network Benchmark\n");
+    printf("=========================\n" RESET);
+    printf("Arrays per method: %d of %d elements\n", count, n);
+
+    int32_t *input = malloc(pool_bytes);
+    int32_t *work = malloc(pool_bytes);
+    int32_t *reference = malloc(pool_bytes);
+
+    srand(42); // Fixed seed so runs are comparable
+    for (int t = 0; t < 2; t++) {
+        for (int i = 0; i < pool * n; i++) {
+            if (types[t] == 'i') input[i] = rand() - RAND_MAX / 2;
+            else ((float*)input)[i] = (float)rand() / RAND_MAX * 2000.0f - 1000.0f;
+        }
+        memcpy(reference, input, pool_bytes);
+        for (int k = 0; k < pool; k++) qsort(reference + (size_t)k * n, n, sizeof(int32_t), types[t] == 'i' ? compare_int : compare_float);
+
+        printf(BOLD "\n%-16s %10s %10s %14s %9s   %s\n" RESET, names[t], "Time (s)", "ns/array", "Arrays/s", "vs qsort", "Result");
+        double times[5] = {0};
+        int ok[5] = {0};
+        for (int method = 4; method >= 0; method--) { // qsort() first, it is the reference for the speedup
+            if (method == 3 && types[t] != 'i') continue;
+
+            double start = now_seconds();
+            int batch = pool;
+            for (int done = 0; done < count; done += batch) {
+                batch = count - done < pool ? count - done : pool;
+                memcpy(work, input, (size_t)batch * n * sizeof(int32_t));
+                for (int k = 0; k < batch; k++) {
+                    int32_t *a = work + (size_t)k * n;
+                    switch (method) {
+                        case 0: sort_network(a, n, types[t]); break;
+                        case 1: if (types[t] == 'i') quick_sort_int_insertion((int*)a, 0, n - 1); else quick_sort_float_insertion((float*)a, 0, n - 1); break;
+                        case 2: quick_sort(a, n, types[t], 0); break;
+                        case 3: merge_sort_reference((int*)a, n); break;
+                        case 4: qsort(a, n, sizeof(int32_t), types[t] == 'i' ? compare_int : compare_float); break;
+                    }
+                }
+            }
+            times[method] = now_seconds() - start;
+            ok[method] = memcmp(work, reference, (size_t)batch * n * sizeof(int32_t)) == 0;
+        }
+
+        for (int method = 0; method < 5; method++) {
+            if (method == 3 && types[t] != 'i') continue;
+            printf("%-16s %10.4f %10.2f %14.0f %8.2fx   ", methods[method], times[method], times[method] / count * 1e9,
+                   times[method] > 0 ? count / times[method] : 0.0, times[method] > 0 ? times[4] / times[method] : 0.0);
+            printf(ok[method] ? GREEN "✓ match" RESET "\n" : RED "✗ MISMATCH" RESET "\n");
+        }
+    }
+
+    // A NaN compares false both ways: the network must keep every element, never copy one into two slots
+    int nan_ok = 1;
+    for (int n_nan = 2; n_nan <= SORT_NETWORK_MAX; n_nan++) {
+        for (int round = 0; round < 1000; round++) {
+            float a[SORT_NETWORK_MAX], before[SORT_NETWORK_MAX];
+            for (int i = 0; i < n_nan; i++) a[i] = (float)(rand() % 100);
+            a[rand() % n_nan] = NAN;
+            memcpy(before, a, n_nan * sizeof(float));
+            sort_network(a, n_nan, 'f');
+
+            // Same multiset: NaNs moved to the end of both copies, the numbers sorted and compared
+            int left = 0;
+            for (int i = 0; i < n_nan; i++) if (!isnan(a[i])) a[left++] = a[i];
+            int nans = n_nan - left;
+            qsort(a, left, sizeof(float), compare_float);
+            int numbers = 0;
+            for (int i = 0; i < n_nan; i++) if (!isnan(before[i])) before[numbers++] = before[i];
+            qsort(before, numbers, sizeof(float), compare_float);
+            if (nans != 1 || numbers != left || memcmp(a, before, left * sizeof(float)) != 0) nan_ok = 0;
+        }
+    }
+    printf("\n%-16s %s\n", "Float with NaN", nan_ok ? GREEN "✓ every element kept" RESET : RED "✗ ELEMENTS LOST" RESET);
+
+    free(input);
+    free(work);
+    free(reference);
+}
+
+/**
+ * Returns a monotonic timestamp in seconds, used for benchmark timing.
+ *
+ * @return          Current monotonic time in seconds.
+ */
+double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Reads whitespace-separated strings of any length from standard input into one arena.
+ *
+ * All characters are appended back to back (each string NUL-terminated) to a single growing buffer,
+ * and the returned array holds one pointer per string into it. Sorting then only moves pointers.
+ * The character that ends the last string is pushed back, so the caller can still clear the line.
+ *
+ * @param size      Number of strings to read.
+ * @param arena     Receives the arena holding the characters. Free it after the pointer array.
+ * @return          Array of `size` pointers into the arena.
+ */
+string_t *read_strings(int size, char **arena) {
+    size_t capacity = 256, used = 0;
+    size_t *offsets = malloc(size * sizeof(size_t)); // Offsets, because the arena may move while growing
+    *arena = malloc(capacity);
+
+    int c = EOF;
+    for (int i = 0; i < size; i++) {
+        c = getchar();
+        while (c != EOF && isspace(c)) c = getchar();
+
+        offsets[i] = used;
+        while (1) {
+            if (used + 1 >= capacity) *arena = realloc(*arena, capacity *= 2);
+            if (c == EOF || isspace(c)) break;
+            (*arena)[used++] = (char)c;
+            c = getchar();
+        }
+        (*arena)[used++] = '\0';
+    }
+    if (c != EOF) ungetc(c, stdin);
+
+    string_t *strings = malloc(size * sizeof(string_t));
+    for (int i = 0; i < size; i++) strings[i] = *arena + offsets[i];
+    free(offsets);
+    return strings;
+}
+
+/**
+ * Prints an array of various types without highlighting.
+ *
+ * Supported types:
+ * - 'i' for int
+ * - 'f' for float
+ * - 'c' for char
+ * - 's' for string (char*) - pointers into one string arena, strings of any length.
+ *
+ * @param arr       Pointer to the array to print.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @return          void
+ */
+void print_array(void *arr, int size, char type) {
+    print_array_with_range(arr, size, type, -1, -1, -1); // Call with no highlighting
+}
+
+/**
+ * Prints an array of various types with highlighting for a specific range and mid-point.
+ *
+ * Supported types:
+ * - 'i' for int
+ * - 'f' for float
+ * - 'c' for char
+ * - 's' for string (char*) - pointers into one string arena, strings of any length.
+ *
+ * @param arr       Pointer to the array to print.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @param left      Left index of the range to highlight. (optional, -1 for no highlight)
+ * @param right     Right index of the range to highlight. (optional, -1 for no highlight)
+ * @param mid       Index of the mid-point to highlight. (optional, -1 for no highlight)
+ * @return          void
+ */
+void print_array_with_range(void *arr, int size, char type, int left, int right, int mid) {
+    printf("[");
+    for (int i = 0; i < size; i++) {
+        if (i < left || (i > right && right != -1)) printf(DIM);
+        else if (i == mid) printf(YELLOW BOLD);
+        else if ((i >= left && left != -1) && i <= right) printf(UNDERLINE);
+
+        switch (type) {
+            case 'i':
+                printf("%d", ((int *)arr)[i]);
+                break;
+            case 'f':
+                printf("%.2f", ((float *)arr)[i]);
+                break;
+            case 'c':
+                printf("'%c'", ((char *)arr)[i]);
+                break;
+            case 's':
+                printf("\"%s\"", ((string_t*)arr)[i]);
+                break;
+            default:
+                printf("Unknown type");
+                return;
+        }
+
+        if (left != -1 || right != -1 || mid != -1) printf(RESET);
+        if (i < size - 1) printf(", ");
+    }
+    printf("]\n");
+}
@@ -0,0 +1,284 @@
+//
+// Created by Dany on 10/17/2026.
+// Copyright (c) 2026 DanyilT. All rights reserved.
+// MIT License: https://github.com/DanyilT/C/blob/main/LICENSE
+// This file is part of 'DanyilT/C' repo: https://github.com/DanyilT/C
+//
+// Array Files: Raw Binary and Line-Delimited Input/Output
+//
+
+#ifndef ARRAY_FILE_H
+#define ARRAY_FILE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// File formats of `--format` and the type codes they load as:
+// - i32:   raw little-endian 32-bit ints ('i')
+// - f32:   raw little-endian 32-bit floats ('f')
+// - u8:    raw bytes, one character each ('c')
+// - lines: one string per line, '\n' or "\r\n" separated ('s', loaded as `char*` pointers)
+
+// i32 and f32 files are little-endian on every host: a big-endian build byte-swaps them after loading and before writing
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define ARRAY_FILE_SWAP 1
+#else
+#define ARRAY_FILE_SWAP 0
+#endif
+
+// An array loaded by `array_file_load()`. The file is mapped privately, so sorting in place never changes it.
+typedef struct {
+    char *map;    // Private writable mapping of the whole file (NULL for an empty file)
+    size_t bytes; // File size in bytes
+    char **lines; // 's': one pointer per line, into `map` or `tail`
+    char *tail;   // 's': NUL-terminated copy of a last line that has no '\n' (there is no byte left to terminate it in place)
+} array_file_t;
+
+// Optional hook of the program: appends its own counters (e.g. ", 12 passes") to the timing line of `sort_array_file()`
+static void (*array_file_report)(FILE *out, int size) = NULL;
+
+/**
+ * Maps a `--format` name to its type code.
+ *
+ * @param format    "i32", "f32", "u8" or "lines".
+ * @return          'i', 'f', 'c' or 's', 0 for an unknown format.
+ */
+static inline char array_file_type(const char *format) {
+    if (!format) return 0;
+    if (strcmp(format, "i32") == 0) return 'i';
+    if (strcmp(format, "f32") == 0) return 'f';
+    if (strcmp(format, "u8") == 0) return 'c';
+    if (strcmp(format, "lines") == 0) return 's';
+    return 0;
+}
+
+/**
+ * Reverses the byte order of 32-bit words in place.
+ *
+ * @param words     Words to swap.
+ * @param count     Number of words.
+ * @return          void
+ */
+static inline void array_file_swap32(uint32_t *words, size_t count) {
+    for (size_t i = 0; i < count; i++) words[i] = __builtin_bswap32(words[i]);
+}
+
+/**
+ * Loads an array file with `mmap()`: raw formats are used where they lie (byte-swapped in place on big-endian hosts),
+ * lines are split in place.
+ *
+ * @param file      Receives the mapping; release it with `array_file_close()` after the last use of the array.
+ * @param path      File to load.
+ * @param type      Type code from `array_file_type()`.
+ * @param size      Receives the number of elements.
+ * @return          Pointer to the elements (`char**` for 's'), NULL on error (message printed to stderr).
+ */
+static inline void *array_file_load(array_file_t *file, const char *path, char type, int *size) {
+    memset(file, 0, sizeof(*file));
+    size_t width = type == 'i' ? sizeof(int) : type == 'f' ? sizeof(float) : 1;
+
+    int fd = open(path, O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0) {
+        fprintf(stderr, "Cannot open input file '%s'!\n", path);
+        if (fd >= 0) close(fd);
+        return NULL;
+    }
+    file->bytes = (size_t)info.st_size;
+    if (type != 's' && file->bytes % width != 0) {
+        fprintf(stderr, "'%s' is %zu bytes, not a whole number of %zu-byte elements!\n", path, file->bytes, width);
+        close(fd);
+        return NULL;
+    }
+
+    if (file->bytes > 0) {
+        int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+        flags |= MAP_POPULATE; // Read the whole file up front in large requests instead of one page fault per page
+#endif
+        file->map = mmap(NULL, file->bytes, PROT_READ | PROT_WRITE, flags, fd, 0);
+        if (file->map == MAP_FAILED) {
+            fprintf(stderr, "Cannot map input file '%s'!\n", path);
+            close(fd);
+            file->map = NULL;
+            return NULL;
+        }
+    }
+    close(fd);
+
+    if (type != 's') {
+        if (file->bytes / width > 0x7fffffff) {
+            fprintf(stderr, "'%s' has more elements than an int can count!\n", path);
+            return NULL;
+        }
+        *size = (int)(file->bytes / width);
+        if (ARRAY_FILE_SWAP && width == 4 && file->map) array_file_swap32((uint32_t*)file->map, file->bytes / 4);
+        return file->map ? (void*)file->map : (void*)file; // Any non-NULL pointer will do for an empty array
+    }
+
+    // Lines: count them, then turn every '\n' (and a '\r' before it) into the terminator of its line
+    size_t count = 0;
+    for (char *p = file->map, *end = file->map + file->bytes; p && p < end; p++) {
+        p = memchr(p, '\n', end - p);
+        if (!p) break;
+        count++;
+    }
+    int unterminated = file->bytes > 0 && file->map[file->bytes - 1] != '\n';
+    file->lines = malloc((count + unterminated + 1) * sizeof(char*));
+
+    int n = 0;
+    char *line = file->map;
+    for (size_t i = 0; i < count; i++) {
+        char *newline = memchr(line, '\n', file->map + file->bytes - line);
+        *newline = '\0';
+        if (newline > line && newline[-1] == '\r') newline[-1] = '\0';
+        file->lines[n++] = line;
+        line = newline + 1;
+    }
+    if (unterminated) {
+        size_t length = file->map + file->bytes - line;
+        file->tail = malloc(length + 1);
+        memcpy(file->tail, line, length);
+        file->tail[length] = '\0';
+        if (length > 0 && file->tail[length - 1] == '\r') file->tail[length - 1] = '\0';
+        file->lines[n++] = file->tail;
+    }
+    *size = n;
+    return file->lines;
+}
+
+/**
+ * Writes an array in the same format it was loaded from, with a single `write()` call (retried only
+ * if the kernel writes less).
+ *
+ * @param path      Output file, NULL or "-" for stdout.
+ * @param arr       Pointer to the elements (`char**` for 's').
+ * @param size      Number of elements.
+ * @param type      Type code ('i', 'f', 'c', 's').
+ * @return          0 on success, 1 on error (message printed to stderr).
+ */
+static inline int array_file_write(const char *path, const void *arr, int size, char type) {
+    const char *data = arr;
+    size_t bytes;
+    char *buffer = NULL;
+
+    if (type == 's') {
+        // Lines are gathered into one buffer, so the output still is a single write
+        char *const *lines = arr;
+        bytes = 0;
+        for (int i = 0; i < size; i++) bytes += strlen(lines[i]) + 1;
+        buffer = malloc(bytes ? bytes : 1);
+        char *out = buffer;
+        for (int i = 0; i < size; i++) {
+            size_t length = strlen(lines[i]);
+            memcpy(out, lines[i], length);
+            out[length] = '\n';
+            out += length + 1;
+        }
+        data = buffer;
+    } else {
+        bytes = (size_t)size * (type == 'i' ? sizeof(int) : type == 'f' ? sizeof(float) : 1);
+        if (ARRAY_FILE_SWAP && type != 'c') {
+            // Swap a copy back to little-endian; the caller's array stays in host order
+            buffer = malloc(bytes ? bytes : 1);
+            memcpy(buffer, arr, bytes);
+            array_file_swap32((uint32_t*)buffer, bytes / 4);
+            data = buffer;
+        }
+    }
+
+    int to_stdout = !path || strcmp(path, "-") == 0;
+    int fd = to_stdout ? STDOUT_FILENO : open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    int ok = fd >= 0;
+    while (ok && bytes > 0) {
+        ssize_t written = write(fd, data, bytes);
+        if (written <= 0) ok = 0;
+        else {
+            data += written;
+            bytes -= (size_t)written;
+        }
+    }
+    if (fd >= 0 && !to_stdout && close(fd) != 0) ok = 0;
+    free(buffer);
+
+    if (!ok) fprintf(stderr, "Cannot write output file '%s'!\n", to_stdout ? "stdout" : path);
+    return !ok;
+}
+
+/**
+ * Releases the mapping and the line pointers of a loaded array file.
+ *
+ * @param file      File loaded by `array_file_load()`.
+ * @return          void
+ */
+static inline void array_file_close(array_file_t *file) {
+    if (file->map) munmap(file->map, file->bytes);
+    free(file->lines);
+    free(file->tail);
+    memset(file, 0, sizeof(*file));
+}
+
+/**
+ * Returns a monotonic timestamp in seconds for the phase timings.
+ *
+ * @return          Current monotonic time in seconds.
+ */
+static inline double array_file_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Loads an array file, sorts it and writes the result without any prompts (`--in`, `--out`, `--format`).
+ *
+ * The phase timings (and whatever `array_file_report` adds) go to stderr, so stdout only carries the sorted
+ * data when no `--out` is given.
+ *
+ * @param input_path  File to sort.
+ * @param output_path Output file, NULL or "-" for stdout.
+ * @param format      "i32", "f32", "u8" or "lines".
+ * @param sort        Sort function called once on the loaded array.
+ * @return            0 on success, 1 on error.
+ */
+static inline int sort_array_file(const char *input_path, const char *output_path, const char *format, void (*sort)(void *arr, int size, char type)) {
+    char type = array_file_type(format);
+    if (!type) {
+        fprintf(stderr, "--in needs --format i32, f32, u8 or lines!\n");
+        return 1;
+    }
+
+    array_file_t file;
+    int size;
+    double start = array_file_seconds();
+    void *arr = array_file_load(&file, input_path, type, &size);
+    if (!arr) return 1;
+    double load_time = array_file_seconds() - start;
+
+    start = array_file_seconds();
+    sort(arr, size, type);
+    double sort_time = array_file_seconds() - start;
+
+    start = array_file_seconds();
+    int status = array_file_write(output_path, arr, size, type);
+    double write_time = array_file_seconds() - start;
+    size_t bytes = file.bytes;
+    array_file_close(&file);
+
+    if (status == 0) {
+        fprintf(stderr, "%d elements (%s): load %.3f s (%.0f MB/s), sort %.3f s, write %.3f s", size, format, load_time,
+                load_time > 0 ? bytes / 1e6 / load_time : 0.0, sort_time, write_time);
+        if (array_file_report) array_file_report(stderr, size);
+        fputc('\n', stderr);
+    }
+    return status;
+}
+
+#endif // ARRAY_FILE_H
@@ -0,0 +1,744 @@
+//
+// Created by Dany on 10/17/2026.
+// Copyright (c) 2026 DanyilT. All rights reserved.
+// MIT License: https://github.com/DanyilT/C/blob/main/LICENSE
+// This file is part of 'DanyilT/C' repo: https://github.com/DanyilT/C
+//
+// Radix Sort (LSD) Implementation in C
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdint.h>
+#include <limits.h>
+#include <time.h>
+#include "ansi_colors.h" // Include ANSI color codes for console output (custom header file)
+#include "array_file.h" // Binary and line-delimited array files for `--in` / `--out` (custom header file)
+#include "text_reader.h" // Buffered `read()` input with a SWAR number parser for the prompts (custom header file)
+#include "sorting_network.h" // Sorting networks for int and float arrays of up to 16 elements (custom header file)
+
+#define RADIX_BITS 8                      // Bits per digit (one counting pass per digit)
+#define RADIX_BUCKETS (1 << RADIX_BITS)   // Buckets per counting pass
+#define KEY_PASSES (32 / RADIX_BITS)      // Passes needed for a 32-bit key
+#define CHAR_IS_SIGNED (CHAR_MIN < 0)     // Plain `char` is signed on most platforms, which changes its byte order
+#define STRING_RADIX_CUTOFF 4096          // Ranges smaller than this go from MSD radix sort to multikey quicksort
+#define STRING_INSERTION_CUTOFF 16        // Partitions of this many strings or fewer are insertion-sorted
+#define STRING_BENCHMARK_LIMIT 10000000   // Largest string benchmark (the URL arena needs ~50 bytes per string)
+
+#define NUMBER_LESS_EQ(a, b) ((a) <= (b))
+#define STRING_LESS_EQ(a, b) (strcmp((a), (b)) <= 0)
+
+typedef char *string_t; // A string is a pointer into one arena, so `string_t *a, *b` declares two arrays of strings
+
+void radix_sort(void *arr, int size, char type, int visualize);
+void sort_file_array(void *arr, int size, char type);
+void radix_sort_keys(uint32_t *keys, uint32_t *scratch, int size, char type, int visualize);
+void print_keys(uint32_t *keys, int size, char type);
+void msd_radix_sort(string_t *arr, string_t *scratch, unsigned char *cache, int left, int right, int depth, int *step, int visualize);
+void multikey_quicksort(string_t *arr, int left, int right, int depth, int *step, int visualize);
+int common_prefix(string_t *arr, int left, int right, int depth);
+void insertion_sort_strings(string_t *arr, int left, int right, int depth);
+void encode_keys(void *arr, int size, char type);
+void decode_keys(void *arr, int size, char type);
+void merge_sort_reference(void *arr, int size, char type);
+void run_benchmark(int size);
+void generate_urls(int size, string_t *strings, char **arena);
+double now_seconds(void);
+string_t *read_strings(int size, char **arena);
+void print_array(void *arr, int size, char type);
+
+int main(int argc, char *argv[]) {
+    int visualize = 0;
+    int benchmark_size = -1;
+    const char *input_path = NULL, *output_path = NULL, *format = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0 || strcmp(argv[i], "--visualize") == 0) visualize = 1; // Enable visualization if -v or --visualize is passed
+        else if (strcmp(argv[i], "--benchmark") == 0) benchmark_size = i + 1 < argc && atoi(argv[i + 1]) > 0 ? atoi(argv[++i]) : 0; // Compare with merge sort (default: 1M, 10M, 100M)
+        else if (strcmp(argv[i], "--in") == 0 && i + 1 < argc) input_path = argv[++i]; // Sort an array file instead of prompting (needs --format)
+        else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) output_path = argv[++i]; // Output file of --in (default: stdout)
+        else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) format = argv[++i]; // Array file format: i32, f32, u8 or lines
+    }
+
+    if (input_path) return sort_array_file(input_path, output_path, format, sort_file_array);
+
+    if (benchmark_size > 0) {
+        run_benchmark(benchmark_size);
+        return 0;
+    }
+    if (benchmark_size == 0) {
+        for (int size = 1000000; size <= 100000000; size *= 10) run_benchmark(size);
+        return 0;
+    }
+
+    setvbuf(stdin, NULL, _IONBF, 0); // The number prompts read stdin with `read()` (text_reader.h), so stdio must not read ahead
+    int choice;
+    printf(MAGENTA "Radix Sort\n");
+    printf("==========\n" RESET);
+    if (visualize) printf(BG_YELLOW "Visualization enabled." RESET "\n");
+    printf("Choose data type:\n");
+    printf("1. Integers\n");
+    printf("2. Floats\n");
+    printf("3. Characters\n");
+    printf("4. Strings\n");
+    printf("Enter your choice (1-4): ");
+    scanf("%d", &choice);
+
+    int size;
+    printf("Enter array size: ");
+    scanf("%d", &size);
+
+    char type = 0;
+    void *arr = NULL;
+    char *arena = NULL; // Backing storage of the strings (type 's')
+
+    switch(choice) {
+        // For integers
+        case 1: {
+            type = 'i';
+            arr = malloc(size * sizeof(int));
+
+            text_reader_t reader;
+            text_reader_open(&reader, STDIN_FILENO);
+            printf("Enter %d integers: ", size);
+            for (int i = 0; i < size; i++) text_reader_int(&reader, &((int*)arr)[i]);
+            text_reader_skip_line(&reader); // Clear input buffer
+            text_reader_close(&reader);
+            break;
+        }
+        // For floats
+        case 2: {
+            type = 'f';
+            arr = malloc(size * sizeof(float));
+
+            text_reader_t reader;
+            text_reader_open(&reader, STDIN_FILENO);
+            printf("Enter %d floats: ", size);
+            for (int i = 0; i < size; i++) text_reader_float(&reader, &((float*)arr)[i]);
+            text_reader_skip_line(&reader); // Clear input buffer
+            text_reader_close(&reader);
+            break;
+        }
+        // For characters
+        case 3: {
+            type = 'c';
+            arr = malloc(size * sizeof(char));
+
+            printf("Enter %d characters: ", size);
+            for (int i = 0; i < size; i++) scanf(" %c", &((char*)arr)[i]);
+            while (getchar() != '\n'); // Clear input buffer
+            break;
+        }
+        // For strings
+        case 4: {
+            type = 's';
+
+            printf("Enter %d strings: ", size);
+            arr = read_strings(size, &arena);
+            while (getchar() != '\n'); // Clear input buffer
+            break;
+        }
+        // Invalid choice
+        default:
+            printf(RED "Invalid choice!\n" RESET);
+            return 1;
+    }
+
+    printf(CYAN "\n-- Radix Sort --\n" RESET);
+
+    printf(YELLOW "\n-- Original Array\n" RESET DIM);
+    print_array(arr, size, type);
+    printf(RESET);
+
+    printf(DIM "Sorting...\n" RESET);
+    radix_sort(arr, size, type, visualize);
+
+    printf(GREEN "\n-- Sorted Array\n" RESET BOLD);
+    print_array(arr, size, type);
+    printf(RESET);
+
+    free(arr);
+    free(arena);
+    return 0;
+}
+
+/**
+ * Sorts an array loaded by `--in` (never visualized).
+ *
+ * @param arr       Pointer to the array to sort.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @return          void
+ */
+void sort_file_array(void *arr, int size, char type) {
+    radix_sort(arr, size, type, 0);
+}
+
+/**
+ * Performs LSD (least significant digit first) radix sort on an array of fixed-width keys.
+ *
+ * Elements are turned in place into unsigned keys whose unsigned order equals the element order
+ * (`encode_keys()`), sorted with 8-bit counting passes, and turned back (`decode_keys()`).
+ * Strings have no fixed width and are sorted most significant character first instead: by
+ * `msd_radix_sort()`, which hands small ranges to `multikey_quicksort()`.
+ *
+ * Supported types:
+ * - 'i' for int
+ * - 'f' for float
+ * - 'c' for char
+ * - 's' for string (char*) - pointers into one string arena, strings of any length.
+ *
+ * @param arr       Pointer to the array to sort.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @param visualize Flag to enable pass-by-pass visualization. (1 = enable, 0 = disable)
+ * @return          void
+ */
+void radix_sort(void *arr, int size, char type, int visualize) {
+    if (size < 2) return;
+    if (!visualize && sort_network(arr, size, type)) return; // Up to 16 ints or floats: cheaper than 4 passes and a malloc
+    if (visualize) printf(BOLD "\nStep-by-step sorting:\n" RESET);
+
+    switch (type) {
+        case 'i':
+        case 'f': {
+            uint32_t *scratch = malloc(size * sizeof(uint32_t));
+            encode_keys(arr, size, type);
+            radix_sort_keys((uint32_t*)arr, scratch, size, type, visualize);
+            decode_keys(arr, size, type);
+            free(scratch);
+            break;
+        }
+        case 'c': {
+            // A single counting pass over the 256 byte values, no scratch buffer needed
+            int counts[RADIX_BUCKETS] = {0};
+            for (int i = 0; i < size; i++) counts[(unsigned char)((char*)arr)[i] ^ (CHAR_IS_SIGNED ? 0x80 : 0)]++;
+            int k = 0;
+            for (int bucket = 0; bucket < RADIX_BUCKETS; bucket++)
+                for (int c = 0; c < counts[bucket]; c++) ((char*)arr)[k++] = (char)(bucket ^ (CHAR_IS_SIGNED ? 0x80 : 0));
+            if (visualize) {
+                printf(CYAN "Pass 1 (counting 256 byte values) -> " RESET);
+                print_array(arr, size, type);
+            }
+            break;
+        }
+        case 's': {
+            int step = 1;
+            string_t *scratch = malloc(size * sizeof(string_t));
+            unsigned char *cache = malloc(size);
+            msd_radix_sort(arr, scratch, cache, 0, size - 1, 0, &step, visualize);
+            free(scratch);
+            free(cache);
+            break;
+        }
+        default:
+            return; // Unsupported type
+    }
+}
+
+/**
+ * Sorts 32-bit unsigned keys with `KEY_PASSES` LSD counting passes of `RADIX_BITS` bits each.
+ *
+ * The histograms of all digits are built in one read of the keys. A pass is skipped when every key
+ * has the same digit in it (its histogram holds a single bucket with all keys), which is common for
+ * small or clustered values. Passes alternate between `keys` and `scratch`; the result ends in `keys`.
+ *
+ * @param keys      Keys to sort (encoded with `encode_keys()`).
+ * @param scratch   Scratch buffer of `size` keys.
+ * @param size      Number of keys.
+ * @param type      Original element type, only used to print the keys for visualization.
+ * @param visualize Flag to enable pass-by-pass visualization. (1 = enable, 0 = disable)
+ * @return          void
+ */
+void radix_sort_keys(uint32_t *keys, uint32_t *scratch, int size, char type, int visualize) {
+    static int counts[KEY_PASSES][RADIX_BUCKETS];
+    memset(counts, 0, sizeof(counts));
+    for (int i = 0; i < size; i++) {
+        uint32_t key = keys[i];
+        for (int pass = 0; pass < KEY_PASSES; pass++) counts[pass][(key >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+    }
+
+    uint32_t *src = keys, *dst = scratch;
+    for (int pass = 0; pass < KEY_PASSES; pass++) {
+        int shift = pass * RADIX_BITS;
+
+        // Every key has the same digit: this pass would not move anything
+        if (counts[pass][(src[0] >> shift) & (RADIX_BUCKETS - 1)] == size) {
+            if (visualize) printf(DIM "Pass %d (bits %d-%d): all keys share one digit, skipped\n" RESET, pass + 1, shift, shift + RADIX_BITS - 1);
+            continue;
+        }
+
+        // Turn the histogram into bucket start offsets, then scatter (stable)
+        int offsets[RADIX_BUCKETS];
+        int total = 0;
+        for (int bucket = 0; bucket < RADIX_BUCKETS; bucket++) {
+            offsets[bucket] = total;
+            total += counts[pass][bucket];
+        }
+        for (int i = 0; i < size; i++) dst[offsets[(src[i] >> shift) & (RADIX_BUCKETS - 1)]++] = src[i];
+
+        uint32_t *temp = src;
+        src = dst;
+        dst = temp;
+
+        if (visualize) {
+            printf(CYAN "Pass %d (bits %d-%d) -> " RESET, pass + 1, shift, shift + RADIX_BITS - 1);
+            print_keys(src, size, type);
+        }
+    }
+
+    if (src != keys) memcpy(keys, src, size * sizeof(uint32_t));
+}
+
+/**
+ * Turns 32-bit elements in place into unsigned keys that sort in the same order as the elements.
+ *
+ * - 'i': the sign bit is flipped, so negative numbers come before positive ones.
+ * - 'f': positive floats get the sign bit set, negative floats have all bits inverted (their
+ *        magnitude order is reversed), so the IEEE-754 bit patterns become ordered.
+ *
+ * @param arr       Pointer to the array of ints or floats.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements: 'i' for int, 'f' for float.
+ * @return          void
+ */
+void encode_keys(void *arr, int size, char type) {
+    uint32_t *keys = arr;
+    for (int i = 0; i < size; i++) {
+        if (type == 'i') keys[i] ^= 0x80000000u;
+        else keys[i] = (keys[i] & 0x80000000u) ? ~keys[i] : keys[i] | 0x80000000u;
+    }
+}
+
+/**
+ * Reverses `encode_keys()`, turning sorted keys back into ints or floats in place.
+ *
+ * @param arr       Pointer to the array of keys.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements: 'i' for int, 'f' for float.
+ * @return          void
+ */
+void decode_keys(void *arr, int size, char type) {
+    uint32_t *keys = arr;
+    for (int i = 0; i < size; i++) {
+        if (type == 'i') keys[i] ^= 0x80000000u;
+        else keys[i] = (keys[i] & 0x80000000u) ? keys[i] ^ 0x80000000u : ~keys[i];
+    }
+}
+
+/**
+ * Prints encoded keys as the original elements (decodes a temporary copy).
+ *
+ * @param keys      Encoded keys.
+ * @param size      Number of keys.
+ * @param type      Original element type: 'i' for int, 'f' for float.
+ * @return          void
+ */
+void print_keys(uint32_t *keys, int size, char type) {
+    uint32_t *copy = malloc(size * sizeof(uint32_t));
+    memcpy(copy, keys, size * sizeof(uint32_t));
+    decode_keys(copy, size, type);
+    print_array(copy, size, type);
+    free(copy);
+}
+
+/**
+ * Sorts strings with MSD (most significant digit first) radix sort, one character per level.
+ *
+ * The character at `depth` of every string is read once into `cache`, counted into 256 buckets and
+ * used to scatter the pointers through `scratch`; every bucket is then sorted from the next character.
+ * Reading each string once per level (instead of once per comparison) matters because the strings
+ * live all over the arena. Ranges below `STRING_RADIX_CUTOFF` go to `multikey_quicksort()`, where
+ * 256 buckets would be mostly empty.
+ *
+ * @param arr       Array of string pointers.
+ * @param scratch   Scratch pointer array with the same indices as `arr`.
+ * @param cache     Scratch byte array with room for one character per string of the whole array.
+ * @param left      Starting index of the range to sort.
+ * @param right     Ending index of the range to sort.
+ * @param depth     Number of leading characters all strings in the range have in common.
+ * @param step      Pointer to step counter for visualization.
+ * @param visualize Flag to enable step-by-step visualization. (1 = enable, 0 = disable)
+ * @return          void
+ */
+void msd_radix_sort(string_t *arr, string_t *scratch, unsigned char *cache, int left, int right, int depth, int *step, int visualize) {
+    if (right - left + 1 < STRING_RADIX_CUTOFF) {
+        multikey_quicksort(arr, left, right, depth, step, visualize);
+        return;
+    }
+
+    int counts[RADIX_BUCKETS];
+    while (1) {
+        memset(counts, 0, sizeof(counts));
+        for (int i = left; i <= right; i++) counts[cache[i] = (unsigned char)arr[i][depth]]++;
+        if (counts[cache[left]] < right - left + 1) break;
+
+        // One bucket holds everything: all strings are equal, or skip past the shared prefix
+        if (cache[left] == '\0') return;
+        depth += 1 + common_prefix(arr, left, right, depth + 1);
+    }
+
+    int offsets[RADIX_BUCKETS];
+    int total = left;
+    for (int bucket = 0; bucket < RADIX_BUCKETS; bucket++) {
+        offsets[bucket] = total;
+        total += counts[bucket];
+    }
+    for (int i = left; i <= right; i++) scratch[offsets[cache[i]]++] = arr[i];
+    memcpy(arr + left, scratch + left, (right - left + 1) * sizeof(string_t));
+
+    if (visualize) printf(CYAN "Step %d: [%d-%d] distributed by character %d\n" RESET, (*step)++, left, right, depth);
+
+    // Bucket 0 holds the strings that ended at `depth`, they are all equal
+    int start = left + counts[0];
+    for (int bucket = 1; bucket < RADIX_BUCKETS; bucket++) {
+        if (counts[bucket] > 1) msd_radix_sort(arr, scratch, cache, start, start + counts[bucket] - 1, depth + 1, step, visualize);
+        start += counts[bucket];
+    }
+}
+
+/**
+ * Sorts strings with three-way radix quicksort (multikey quicksort), most significant character first.
+ *
+ * Every string in `arr[left..right]` is known to share its first `depth` characters. The range is
+ * partitioned on the character at `depth` only into `<`, `==` and `>` the pivot character; the `==`
+ * part moves on to the next character, so a shared prefix is read once per level instead of once
+ * per comparison as with `strcmp()`. Small ranges are insertion-sorted from `depth` on.
+ *
+ * @param arr       Array of string pointers.
+ * @param left      Starting index of the range to sort.
+ * @param right     Ending index of the range to sort.
+ * @param depth     Number of leading characters all strings in the range have in common.
+ * @param step      Pointer to step counter for visualization.
+ * @param visualize Flag to enable step-by-step visualization. (1 = enable, 0 = disable)
+ * @return          void
+ */
+void multikey_quicksort(string_t *arr, int left, int right, int depth, int *step, int visualize) {
+    // Visualization looks at every partition, even the small ones
+    if (right - left < (visualize ? 1 : STRING_INSERTION_CUTOFF)) {
+        if (right > left) insertion_sort_strings(arr, left, right, depth);
+        return;
+    }
+
+    int common = common_prefix(arr, left, right, depth);
+    if (common > 0) {
+        if (visualize) printf(DIM "Step %d: [%d-%d] share %d more characters, skipped to character %d\n" RESET, (*step)++, left, right, common, depth + common);
+        depth += common;
+    }
+
+    // Median of three characters (first, middle, last) as the pivot
+    int mid = left + (right - left) / 2;
+    int a = (unsigned char)arr[left][depth], b = (unsigned char)arr[mid][depth], c = (unsigned char)arr[right][depth];
+    int median = (a < b) ? (b < c ? mid : (a < c ? right : left)) : (a < c ? left : (b < c ? right : mid));
+    string_t temp = arr[left];
+    arr[left] = arr[median];
+    arr[median] = temp;
+    int pivot = (unsigned char)arr[left][depth];
+
+    // Three-way partition: [left, lt) < pivot, [lt, gt] == pivot, (gt, right] > pivot
+    int lt = left, gt = right, i = left + 1;
+    while (i <= gt) {
+        int ch = (unsigned char)arr[i][depth];
+        if (ch < pivot) {
+            temp = arr[lt]; arr[lt++] = arr[i]; arr[i++] = temp;
+        } else if (ch > pivot) {
+            temp = arr[gt]; arr[gt--] = arr[i]; arr[i] = temp;
+        } else {
+            i++;
+        }
+    }
+
+    if (visualize) {
+        if (pivot) printf(CYAN "Step %d: [%d-%d] character %d, pivot '%c' -> " RESET, (*step)++, left, right, depth, pivot);
+        else printf(CYAN "Step %d: [%d-%d] character %d, pivot end of string -> " RESET, (*step)++, left, right, depth);
+        print_array(arr + left, right - left + 1, 's');
+    }
+
+    multikey_quicksort(arr, left, lt - 1, depth, step, visualize);
+    if (pivot != '\0') multikey_quicksort(arr, lt, gt, depth + 1, step, visualize); // Strings that ended here are all equal
+    multikey_quicksort(arr, gt + 1, right, depth, step, visualize);
+}
+
+/**
+ * Returns how many characters after `depth` all strings in a range have in common.
+ *
+ * Every string is compared with the first one in a single sequential scan, stopping as soon as the
+ * common part is empty. This replaces one partition or distribution pass over the range per shared
+ * character, which is what makes long shared prefixes (URLs, paths) cheap.
+ *
+ * @param arr       Array of string pointers.
+ * @param left      Starting index of the range.
+ * @param right     Ending index of the range.
+ * @param depth     Number of leading characters all strings in the range are known to share.
+ * @return          Number of further shared characters (0 if the strings differ at `depth`).
+ */
+int common_prefix(string_t *arr, int left, int right, int depth) {
+    string_t first = arr[left] + depth;
+    int common = (int)strlen(first);
+    for (int i = left + 1; i <= right && common > 0; i++) {
+        string_t other = arr[i] + depth;
+        int k = 0;
+        while (k < common && other[k] == first[k]) k++;
+        common = k;
+    }
+    return common;
+}
+
+/**
+ * Insertion-sorts a small range of strings that share their first `depth` characters.
+ *
+ * @param arr       Array of string pointers.
+ * @param left      Starting index of the range to sort.
+ * @param right     Ending index of the range to sort.
+ * @param depth     Number of leading characters all strings in the range have in common (skipped by the comparison).
+ * @return          void
+ */
+void insertion_sort_strings(string_t *arr, int left, int right, int depth) {
+    for (int i = left + 1; i <= right; i++) {
+        string_t key = arr[i];
+        int j = i - 1;
+        while (j >= left && strcmp(arr[j] + depth, key + depth) > 0) {
+            arr[j + 1] = arr[j];
+            j--;
+        }
+        arr[j + 1] = key;
+    }
+}
+
+/**
+ * Defines a bottom-up merge sort for one element type.
+ *
+ * This mirrors the typed kernels of `sorting/merge_sort` (one scratch buffer, stable merge) and is
+ * only used as the comparison point of `--benchmark`.
+ *
+ * @param name      Name of the generated function.
+ * @param T         Element type.
+ * @param less_eq   Comparison macro, `less_eq(a, b)` is true when `a` may stay before `b`.
+ */
+#define DEFINE_REFERENCE_MERGE_SORT(name, T, less_eq)                                                                                 \
+void name(T *arr, int size) {                                                                                                \
+    T *scratch = malloc(size * sizeof(T));                                                                                      \
+    T *src = arr, *dst = scratch;                                                                                               \
+    for (int width = 1; width < size; width *= 2) {                                                                             \
+        for (int left = 0; left < size; left += 2 * width) {                                                                    \
+            int mid = left + width < size ? left + width : size;                                                                \
+            int right = mid + width < size ? mid + width : size;                                                                \
+            int i = left, j = mid, k = left;                                                                                    \
+            while (i < mid && j < right) dst[k++] = less_eq(src[i], src[j]) ? src[i++] : src[j++];                                \
+            while (i < mid) dst[k++] = src[i++];                                                                                \
+            while (j < right) dst[k++] = src[j++];                                                                              \
+        }                                                                                                                       \
+        T *temp = src;                                                                                                          \
+        src = dst;                                                                                                              \
+        dst = temp;                                                                                                             \
+    }                                                                                                                           \
+    if (src != arr) memcpy(arr, src, size * sizeof(T));                                                                         \
+    free(scratch);                                                                                                              \
+}
+
+DEFINE_REFERENCE_MERGE_SORT(merge_sort_reference_int, int, NUMBER_LESS_EQ)
+DEFINE_REFERENCE_MERGE_SORT(merge_sort_reference_float, float, NUMBER_LESS_EQ)
+DEFINE_REFERENCE_MERGE_SORT(merge_sort_reference_char, char, NUMBER_LESS_EQ)
+DEFINE_REFERENCE_MERGE_SORT(merge_sort_reference_string, string_t, STRING_LESS_EQ)
+
+/**
+ * Sorts an array with the benchmark's reference merge sort.
+ *
+ * @param arr       Pointer to the array to sort.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements: 'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @return          void
+ */
+void merge_sort_reference(void *arr, int size, char type) {
+    switch (type) {
+        case 'i': merge_sort_reference_int(arr, size); break;
+        case 'f': merge_sort_reference_float(arr, size); break;
+        case 'c': merge_sort_reference_char(arr, size); break;
+        case 's': merge_sort_reference_string(arr, size); break;
+        default: return;
+    }
+}
+
+/**
+ * Benchmarks radix sort against merge sort on random integers, floats, characters and strings.
+ *
+ * Both sorts get the same random input (including negative numbers); the results are compared
+ * element by element. The strings are URLs with long shared prefixes (`generate_urls()`), the case
+ * where `strcmp()`-based sorts keep re-reading the same characters. They are skipped above
+ * `STRING_BENCHMARK_LIMIT` elements.
+ *
+ * @param size      Number of random elements per type.
+ * @return          void
+ */
+void run_benchmark(int size) {
+    const char types[] = {'i', 'f', 'c', 's'};
+    const char *names[] = {"Integers", "Floats", "Characters", "URLs"};
+    const size_t widths[] = {sizeof(int), sizeof(float), sizeof(char), sizeof(string_t)};
+
+    printf(MAGENTA "Radix Sort Benchmark" RESET " (%d elements)\n", size);
+    printf(BOLD "%-12s %14s %12s %10s   %s\n" RESET, "Type", "Merge sort (s)", "Radix (s)", "Speedup", "Result");
+
+    srand(42); // Fixed seed so runs are comparable
+    for (int t = 0; t < 4; t++) {
+        if (types[t] == 's' && size > STRING_BENCHMARK_LIMIT) {
+            printf(DIM "%-12s skipped (more than %d strings)\n" RESET, names[t], STRING_BENCHMARK_LIMIT);
+            continue;
+        }
+
+        char *arena = NULL;
+        char *input = malloc(size * widths[t]);
+        char *radix = malloc(size * widths[t]);
+        char *merge = malloc(size * widths[t]);
+
+        for (int i = 0; i < size; i++) {
+            switch (types[t]) {
+                case 'i': ((int*)input)[i] = rand() - RAND_MAX / 2; break;
+                case 'f': ((float*)input)[i] = (float)rand() / RAND_MAX * 2000.0f - 1000.0f; break;
+                case 'c': ((char*)input)[i] = (char)(' ' + rand() % 95); break;
+            }
+        }
+        if (types[t] == 's') generate_urls(size, (string_t*)input, &arena);
+        memcpy(radix, input, size * widths[t]);
+        memcpy(merge, input, size * widths[t]);
+
+        double start = now_seconds();
+        merge_sort_reference(merge, size, types[t]);
+        double merge_time = now_seconds() - start;
+
+        start = now_seconds();
+        radix_sort(radix, size, types[t], 0);
+        double radix_time = now_seconds() - start;
+
+        int ok = 1;
+        for (int i = 0; i < size && ok; i++) {
+            switch (types[t]) {
+                case 'i': ok = ((int*)radix)[i] == ((int*)merge)[i]; break;
+                case 'f': ok = ((float*)radix)[i] == ((float*)merge)[i]; break;
+                case 'c': ok = ((char*)radix)[i] == ((char*)merge)[i]; break;
+                case 's': ok = strcmp(((string_t*)radix)[i], ((string_t*)merge)[i]) == 0; break;
+            }
+        }
+
+        printf("%-12s %14.4f %12.4f %9.2fx   ", names[t], merge_time, radix_time, radix_time > 0 ? merge_time / radix_time : 0.0);
+        printf(ok ? GREEN "✓ match" RESET "\n" : RED "✗ MISMATCH" RESET "\n");
+
+        free(input);
+        free(radix);
+        free(merge);
+        free(arena);
+    }
+}
+
+/**
+ * Fills `strings` with random product URLs that share long prefixes, stored back to back in one arena.
+ *
+ * Every URL starts with the same 51 characters, followed by one of 20 categories and a random item id,
+ * e.g. `https://shop.example.com/catalog/products/category-07/item-0412345?ref=home`.
+ *
+ * @param size      Number of URLs to generate.
+ * @param strings   Receives `size` pointers into the arena.
+ * @param arena     Receives the arena buffer (freed by the caller after the pointer array).
+ * @return          void
+ */
+void generate_urls(int size, string_t *strings, char **arena) {
+    const int url_length = 80; // Upper bound of one URL including '\0'
+    *arena = malloc((size_t)size * url_length);
+
+    char *next = *arena;
+    for (int i = 0; i < size; i++) {
+        strings[i] = next;
+        next += sprintf(next, "https://shop.example.com/catalog/products/category-%02d/item-%07d?ref=home", rand() % 20, rand() % 10000000) + 1;
+    }
+}
+
+/**
+ * Returns a monotonic timestamp in seconds, used for benchmark timing.
+ *
+ * @return          Current monotonic time in seconds.
+ */
+double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Reads `size` whitespace-separated strings of any length into one arena.
+ *
+ * The characters of all strings are stored back to back (each terminated by '\0') in a single
+ * buffer, so sorting only has to move pointers.
+ *
+ * @param size      Number of strings to read.
+ * @param arena     Receives the arena buffer (freed by the caller after the pointer array).
+ * @return          Array of `size` pointers into the arena.
+ */
+string_t *read_strings(int size, char **arena) {
+    size_t capacity = 256, used = 0;
+    size_t *offsets = malloc(size * sizeof(size_t)); // Offsets, because the arena may move while growing
+    *arena = malloc(capacity);
+
+    int c = EOF;
+    for (int i = 0; i < size; i++) {
+        c = getchar();
+        while (c != EOF && isspace(c)) c = getchar();
+
+        offsets[i] = used;
+        while (1) {
+            if (used + 1 >= capacity) *arena = realloc(*arena, capacity *= 2);
+            if (c == EOF || isspace(c)) break;
+            (*arena)[used++] = (char)c;
+            c = getchar();
+        }
+        (*arena)[used++] = '\0';
+    }
+    if (c != EOF) ungetc(c, stdin);
+
+    string_t *strings = malloc(size * sizeof(string_t));
+    for (int i = 0; i < size; i++) strings[i] = *arena + offsets[i];
+    free(offsets);
+    return strings;
+}
+
+/**
+ * Prints an array of various types.
+ *
+ * Supported types:
+ * - 'i' for int
+ * - 'f' for float
+ * - 'c' for char
+ * - 's' for string (char*)
+ *
+ * @param arr       Pointer to the array to print.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @return          void
+ */
+void print_array(void *arr, int size, char type) {
+    printf("[");
+    for (int i = 0; i < size; i++) {
+        switch (type) {
+            case 'i':
+                printf("%d", ((int *)arr)[i]);
+                break;
+            case 'f':
+                printf("%.2f", ((float *)arr)[i]);
+                break;
+            case 'c':
+                printf("'%c'", ((char *)arr)[i]);
+                break;
+            case 's':
+                printf("\"%s\"", ((string_t *)arr)[i]);
+                break;
+            default:
+                printf("Unknown type");
+                return;
+        }
+
+        if (i < size - 1) printf(", ");
+    }
+    printf("]\n");
+}
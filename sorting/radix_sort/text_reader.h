@@ -0,0 +1,331 @@
+//
+// Created by Dany on 10/17/2026.
+// Copyright (c) 2026 DanyilT. All rights reserved.
+// MIT License: https://github.com/DanyilT/C/blob/main/LICENSE
+// This file is part of 'DanyilT/C' repo: https://github.com/DanyilT/C
+//
+// Text Reader: Buffered read() Input with a SWAR Integer Parser
+//
+
+#ifndef TEXT_READER_H
+#define TEXT_READER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#define TEXT_READER_CHUNK (1 << 20) // Bytes requested from `read()` at a time
+#define TEXT_READER_PADDING 8       // Zero bytes kept after the data, so an 8-byte load never leaves the buffer
+
+// Numbers are parsed leniently, like `scanf("%*[^-0-9]%d")`: every byte that cannot start a number
+// separates numbers, so "3, 2;8 13" reads as 3 2 8 13. A '-' only counts directly before a digit
+// (or before a '.' for floats).
+typedef struct {
+    int fd;          // File descriptor read with `read()` (not closed by `text_reader_close()`)
+    char *buffer;    // `capacity` bytes of data plus `TEXT_READER_PADDING` zero bytes
+    size_t capacity;
+    size_t position; // Next unread byte
+    size_t length;   // Bytes of data in `buffer`; buffer[length..length + TEXT_READER_PADDING) are always zero
+    int eof;         // `read()` returned 0 (or failed)
+} text_reader_t;
+
+/**
+ * Starts reading a file descriptor.
+ *
+ * Reading stdin this way bypasses stdio, so call `setvbuf(stdin, NULL, _IONBF, 0)` before the first
+ * `scanf()`: a buffered stdin would read ahead and swallow input meant for the reader.
+ *
+ * @param reader    Reader to initialize; release it with `text_reader_close()`.
+ * @param fd        File descriptor to read (e.g. `STDIN_FILENO`).
+ * @return          void
+ */
+static inline void text_reader_open(text_reader_t *reader, int fd) {
+    reader->fd = fd;
+    reader->capacity = TEXT_READER_CHUNK;
+    reader->buffer = calloc(reader->capacity + TEXT_READER_PADDING, 1);
+    reader->position = reader->length = 0;
+    reader->eof = 0;
+}
+
+/**
+ * Frees the buffer of a reader; unread input is dropped.
+ *
+ * @param reader    Reader to release.
+ * @return          void
+ */
+static inline void text_reader_close(text_reader_t *reader) {
+    free(reader->buffer);
+    reader->buffer = NULL;
+}
+
+/**
+ * Moves the unread bytes to the front of the buffer and appends the result of one `read()` call.
+ *
+ * A single call keeps terminals responsive: it returns after one line instead of waiting for a full
+ * chunk. The buffer doubles when the unread bytes fill it (a token longer than the buffer).
+ *
+ * @param reader    Reader to refill.
+ * @return          Number of bytes added, 0 at the end of the input.
+ */
+static inline size_t text_reader_fill(text_reader_t *reader) {
+    if (reader->eof) return 0;
+
+    size_t unread = reader->length - reader->position;
+    memmove(reader->buffer, reader->buffer + reader->position, unread);
+    reader->position = 0;
+    reader->length = unread;
+    if (unread == reader->capacity) {
+        reader->capacity *= 2;
+        reader->buffer = realloc(reader->buffer, reader->capacity + TEXT_READER_PADDING);
+    }
+
+    if (reader->fd == STDIN_FILENO) fflush(stdout); // Show a pending prompt before blocking, like stdio does
+    ssize_t got = read(reader->fd, reader->buffer + reader->length, reader->capacity - reader->length);
+    if (got <= 0) {
+        reader->eof = 1;
+        got = 0;
+    }
+    reader->length += (size_t)got;
+    memset(reader->buffer + reader->length, 0, TEXT_READER_PADDING);
+    return (size_t)got;
+}
+
+/**
+ * Marks the ASCII digits among 8 bytes loaded little-endian (SWAR: all 8 bytes tested at once).
+ *
+ * Per byte, adding 0x50 to its low 7 bits sets bit 7 exactly when it is >= '0', and adding 0x46
+ * sets it exactly when it is > '9'; neither sum carries into the next byte.
+ *
+ * @param chunk     Eight input bytes, the first one in the lowest byte.
+ * @return          Bit 7 of every byte set where that byte is a digit, all other bits clear.
+ */
+static inline uint64_t text_reader_digit_mask(uint64_t chunk) {
+    const uint64_t high_bits = 0x8080808080808080ULL;
+    uint64_t low = chunk & ~high_bits;
+    return (low + 0x5050505050505050ULL) & ~(low + 0x4646464646464646ULL) & ~chunk & high_bits;
+}
+
+/**
+ * Counts the leading ASCII digits of 8 bytes loaded little-endian.
+ *
+ * @param chunk     Eight input bytes, the first one in the lowest byte.
+ * @return          Number of digits before the first non-digit (8 if all are digits).
+ */
+static inline int text_reader_digit_count(uint64_t chunk) {
+    uint64_t others = ~text_reader_digit_mask(chunk) & 0x8080808080808080ULL;
+    return others ? __builtin_ctzll(others) >> 3 : 8;
+}
+
+/**
+ * Converts the first `count` digits of 8 bytes loaded little-endian to their value, with three
+ * multiplications instead of one per digit.
+ *
+ * The digits are shifted to the top bytes (the bytes below become leading zeros), then neighbouring
+ * bytes, 16-bit and 32-bit halves are combined pairwise: 8 x 1 digit -> 4 x 2 -> 2 x 4 -> 1 x 8.
+ *
+ * @param chunk     Eight input bytes, the first one in the lowest byte.
+ * @param count     Number of leading digits to convert (1 to 8).
+ * @return          Value of the digits.
+ */
+static inline uint32_t text_reader_digits_value(uint64_t chunk, int count) {
+    chunk = (chunk & 0x0f0f0f0f0f0f0f0fULL) << (8 * (8 - count));
+    chunk = (chunk * 2561) >> 8 & 0x00ff00ff00ff00ffULL;            // 2561 = 10 << 8 | 1
+    chunk = (chunk * 6553601) >> 16 & 0x0000ffff0000ffffULL;        // 6553601 = 100 << 16 | 1
+    return (uint32_t)((chunk * 42949672960001ULL) >> 32);           // 42949672960001 = 10000 << 32 | 1
+}
+
+/**
+ * Loads 8 bytes with the first byte in the lowest position, whatever the host byte order.
+ *
+ * @param bytes     First byte to load.
+ * @return          The 8 bytes as one little-endian word.
+ */
+static inline uint64_t text_reader_load(const char *bytes) {
+    uint64_t chunk;
+    memcpy(&chunk, bytes, sizeof(chunk));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    chunk = __builtin_bswap64(chunk);
+#endif
+    return chunk;
+}
+
+/**
+ * Parses the run of digits at the current position, 8 bytes per step, refilling the buffer when the
+ * run reaches the end of the data.
+ *
+ * @param reader    Reader positioned at the first digit; left after the last one.
+ * @param count     Receives the number of digits (may be NULL).
+ * @return          Value of the digits, modulo 2^64.
+ */
+static inline uint64_t text_reader_digits(text_reader_t *reader, int *count) {
+    static const uint64_t powers[9] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+    uint64_t value = 0;
+    int total = 0;
+    while (1) {
+        uint64_t chunk = text_reader_load(reader->buffer + reader->position); // The zero padding stops a run at the data end
+        int digits = text_reader_digit_count(chunk);
+        if (digits > 0) {
+            value = value * powers[digits] + text_reader_digits_value(chunk, digits);
+            reader->position += digits;
+            total += digits;
+        }
+        if (digits == 8) continue;
+        if (reader->position < reader->length || !text_reader_fill(reader)) break; // Ended at a separator or at the end of the input
+    }
+    if (count) *count = total;
+    return value;
+}
+
+/**
+ * Skips separators up to the next byte that starts a number.
+ *
+ * @param reader    Reader to advance.
+ * @param floats    1 to also accept a '.' as the start of a number (floats), 0 for integers.
+ * @return          1 if a number starts at the current position, 0 at the end of the input.
+ */
+static inline int text_reader_skip_separators(text_reader_t *reader, int floats) {
+    while (1) {
+        if (reader->position + 1 >= reader->length && !reader->eof) {
+            text_reader_fill(reader); // Keeps at least the next two bytes in view
+            continue;
+        }
+        if (reader->position >= reader->length) return 0;
+
+        char c = reader->buffer[reader->position], next = reader->buffer[reader->position + 1];
+        if (c >= '0' && c <= '9') return 1;
+        if (floats && c == '.' && next >= '0' && next <= '9') return 1;
+        if (c == '-' && ((next >= '0' && next <= '9') || (floats && next == '.'))) return 1;
+        reader->position++;
+    }
+}
+
+/**
+ * Reads the next integer, skipping anything before it that is not a digit or a '-' before a digit.
+ *
+ * Values outside the `int` range wrap around instead of being clamped.
+ *
+ * @param reader    Reader to parse from.
+ * @param value     Receives the integer (unchanged at the end of the input).
+ * @return          1 if an integer was read, 0 at the end of the input.
+ */
+static inline int text_reader_int(text_reader_t *reader, int *value) {
+    // Fast path away from the end of the data: up to 7 separators and up to 15 digits, without
+    // a loop per byte or per 8 digits
+    if (reader->length - reader->position >= 32) {
+        static const uint32_t powers[9] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+        const char *text = reader->buffer + reader->position;
+        uint64_t digits = text_reader_digit_mask(text_reader_load(text));
+        if (digits) {
+            int skip = __builtin_ctzll(digits) >> 3; // Separators before the first digit
+            int negative = skip > 0 && text[skip - 1] == '-';
+            uint64_t first = text_reader_load(text + skip);
+            uint64_t others = ~text_reader_digit_mask(first) & 0x8080808080808080ULL;
+            uint32_t magnitude;
+            int count;
+            if (others) { // Up to 7 digits
+                count = __builtin_ctzll(others) >> 3;
+                magnitude = text_reader_digits_value(first, count);
+            } else { // 8 to 15 digits
+                uint64_t second = text_reader_load(text + skip + 8);
+                others = ~text_reader_digit_mask(second) & 0x8080808080808080ULL;
+                count = others ? __builtin_ctzll(others) >> 3 : 8;
+                magnitude = text_reader_digits_value(first, 8);
+                if (count == 8) others = 0; // 16+ digits: leave them to the general path
+                else if (count) magnitude = magnitude * powers[count] + text_reader_digits_value(second, count);
+                count += 8;
+            }
+            if (others) {
+                reader->position += skip + count;
+                *value = (int)(negative ? 0u - magnitude : magnitude);
+                return 1;
+            }
+        }
+    }
+
+    if (!text_reader_skip_separators(reader, 0)) return 0;
+    int negative = reader->buffer[reader->position] == '-';
+    reader->position += negative;
+    uint32_t magnitude = (uint32_t)text_reader_digits(reader, NULL);
+    *value = (int)(negative ? 0u - magnitude : magnitude);
+    return 1;
+}
+
+/**
+ * Reads the next float, skipping anything before it that is not a digit, a '.' or a '-'.
+ *
+ * Plain decimals with up to 7 significant digits (the common case) are converted exactly with one
+ * float division; exponents, longer mantissas and everything else `strtof()` accepts go to `strtof()`.
+ *
+ * @param reader    Reader to parse from.
+ * @param value     Receives the float (unchanged at the end of the input).
+ * @return          1 if a float was read, 0 at the end of the input.
+ */
+static inline int text_reader_float(text_reader_t *reader, float *value) {
+    static const float powers[11] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+    while (text_reader_skip_separators(reader, 1)) {
+        // Bring the whole token into the buffer, so `strtof()` never sees a cut-off number
+        size_t end = reader->position;
+        while (1) {
+            char c = reader->buffer[end];
+            if (end < reader->length && ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '.' || c == '+' || c == '-')) end++;
+            else if (end == reader->length && !reader->eof) {
+                end -= reader->position;
+                text_reader_fill(reader);
+            } else break;
+        }
+
+        char *start = reader->buffer + reader->position;
+        size_t position = reader->position;
+        int negative = *start == '-';
+        reader->position += negative;
+        int integer_digits, fraction_digits = 0;
+        uint64_t mantissa = text_reader_digits(reader, &integer_digits);
+        if (reader->buffer[reader->position] == '.') {
+            reader->position++;
+            uint64_t fraction = text_reader_digits(reader, &fraction_digits);
+            if (fraction_digits <= 10) {
+                static const uint64_t scales[11] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000, 10000000000ULL};
+                mantissa = mantissa * scales[fraction_digits] + fraction;
+            }
+        }
+        int digits = integer_digits + fraction_digits;
+        if (digits > 0 && digits <= 18 && fraction_digits <= 10 && mantissa < (1u << 24) && reader->position == end) {
+            float magnitude = (float)mantissa / powers[fraction_digits]; // Both exact, so the division rounds once
+            *value = negative ? -magnitude : magnitude;
+            return 1;
+        }
+
+        char *parsed;
+        float result = strtof(start, &parsed); // Stops at the separator or the zero padding after the token
+        if (parsed > start) {
+            reader->position = position + (size_t)(parsed - start);
+            *value = result;
+            return 1;
+        }
+        reader->position = position + 1; // Not a number after all (e.g. "-.x"): skip the byte
+    }
+    return 0;
+}
+
+/**
+ * Drops the rest of the current line (like `while (getchar() != '\n');`), without blocking at the
+ * end of the input.
+ *
+ * @param reader    Reader to advance.
+ * @return          void
+ */
+static inline void text_reader_skip_line(text_reader_t *reader) {
+    while (1) {
+        char *newline = memchr(reader->buffer + reader->position, '\n', reader->length - reader->position);
+        if (newline) {
+            reader->position = (size_t)(newline - reader->buffer) + 1;
+            return;
+        }
+        reader->position = reader->length;
+        if (!text_reader_fill(reader)) return;
+    }
+}
+
+#endif // TEXT_READER_H
@@ -10,22 +10,106 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
+#include <stdint.h>
+#include <time.h>
 #include "ansi_colors.h" // Include ANSI color codes for console output (custom header file)
+#include "array_file.h" // Binary and line-delimited array files for `--in` / `--out` (custom header file)
+#include "text_reader.h" // Buffered `read()` input with a SWAR number parser for the prompts (custom header file)
+#include "sorting_network.h" // Sorting networks for int and float arrays of up to 16 elements (custom header file)
 
-#define STRING_LENGTH 50
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86_SIMD 1 // SSE2 and AVX2 argmin kernels are compiled in (chosen at runtime)
+#else
+#define HAVE_X86_SIMD 0 // Only the scalar argmin kernels exist
+#endif
+
+#define DEFAULT_BENCHMARK_SIZE 4096   // Largest array size of `--benchmark` without an argument
+#define BENCHMARK_COMPARISONS 200000000 // Comparisons per benchmark cell; repetitions = this / (n^2 / 2)
+#define TOP_K_SCAN_MAX 4 // `--top K` on ints and floats: up to this many argmin passes beat a heap
+#define TOP_K_HEAP_DIVISOR 64 // `--top K` keeps a bounded heap while K <= n / this, introselect above
+#define TOP_K_SELECT_BUDGET 4 // Introselect switches to median-of-medians pivots after partitioning this many times n elements
+#define TOP_K_INSERTION_CUTOFF 16 // Introselect ranges smaller than this are finished with insertion sort
+#define DEFAULT_TOP_BENCHMARK_SIZE 1000000 // Array size of `--top-benchmark` without an argument
+
+// Argmin kernels look at ints and floats as 32-bit keys, so they can share one swap and one signature
+typedef int (*argmin_fn)(const int32_t *keys, int n);
+typedef void (*argminmax_fn)(const int32_t *keys, int n, int *min_index, int *max_index);
+
+// One implementation level of the argmin kernels (scalar, SSE2, AVX2)
+typedef struct {
+    const char *name;
+    argmin_fn argmin_int, argmin_float;
+    argminmax_fn argminmax_int, argminmax_float;
+} argmin_kernels_t;
+
+// Ways to find the K smallest elements (`--top K`), chosen by `top_k_strategy()`
+typedef enum { TOP_K_SCAN, TOP_K_HEAP, TOP_K_SELECT, TOP_K_STRATEGY_COUNT } top_k_strategy_t;
+const char *top_k_names[TOP_K_STRATEGY_COUNT] = {"Min-scan", "Bounded heap", "Introselect"};
+
+int double_ended = 0; // Place the minimum and the maximum in every pass (`--double-ended`)
+int top_k = 0; // Only find the K smallest elements, in order (`--top K`)
 
 void selection_sort(void *arr, int size, char type, int visualize);
+void selection_sort_generic(void *arr, int size, char type, int visualize);
+void sort_file_array(void *arr, int size, char type);
+void selection_sort_kernel(void *arr, int size, char type, const argmin_kernels_t *kernels);
+void selection_sort_passes(void *arr, int size, int passes, char type, const argmin_kernels_t *kernels);
+top_k_strategy_t top_k_strategy(int size, int k, char type);
+void select_top_k(void *arr, int size, int k, char type, top_k_strategy_t strategy);
+int top_k_array_file(const char *input_path, const char *output_path, const char *format, int k);
+void run_top_k_benchmark(int size);
+void selection_sort_double_ended(void *arr, int size, char type, const argmin_kernels_t *kernels);
+void find_min_max(void *arr, int left, int right, char type, const argmin_kernels_t *kernels, int *min_index, int *max_index);
+void swap_elements(void *arr, int a, int b, char type);
+int reduce_lanes(const int32_t *lane_keys, const int32_t *lane_index, int lanes, int want_max, int32_t *best_key);
+int cpu_simd_level(void);
+const argmin_kernels_t *active_kernels(void);
+int compare_int(const void *a, const void *b);
+int compare_float(const void *a, const void *b);
+void run_benchmark(int max_size);
+double now_seconds(void);
 void print_array(void *arr, int size, char type);
+char **read_strings(int size, char **arena);
 void print_array_with_highlight(void *arr, int size, char type, int sorted_boundary, int current, int min_index);
 
 int main(int argc, char *argv[]) {
     int visualize = 0;
-    if (argc > 1) if (strcmp(argv[1], "-v") == 0 || strcmp(argv[1], "--visualize") == 0) visualize = 1; // Enable visualization if -v or --visualize is passed
+    int benchmark_size = -1;
+    int top_benchmark_size = 0;
+    const char *input_path = NULL, *output_path = NULL, *format = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0 || strcmp(argv[i], "--visualize") == 0) visualize = 1; // Enable visualization if -v or --visualize is passed
+        else if (strcmp(argv[i], "--double-ended") == 0) double_ended = 1; // Place the minimum and the maximum in every pass
+        else if (strcmp(argv[i], "--benchmark") == 0) benchmark_size = i + 1 < argc && atoi(argv[i + 1]) > 0 ? atoi(argv[++i]) : DEFAULT_BENCHMARK_SIZE; // Compare argmin kernels up to N elements
+        else if (strcmp(argv[i], "--top") == 0 && i + 1 < argc) top_k = atoi(argv[++i]); // Only find the K smallest elements (K <= 0 sorts everything)
+        else if (strcmp(argv[i], "--top-benchmark") == 0) top_benchmark_size = i + 1 < argc && atoi(argv[i + 1]) > 0 ? atoi(argv[++i]) : DEFAULT_TOP_BENCHMARK_SIZE; // Compare the top-k strategies on N elements
+        else if (strcmp(argv[i], "--in") == 0 && i + 1 < argc) input_path = argv[++i]; // Sort an array file instead of prompting (needs --format)
+        else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) output_path = argv[++i]; // Output file of --in (default: stdout)
+        else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) format = argv[++i]; // Array file format: i32, f32, u8 or lines
+    }
+
+    if (input_path && top_k > 0) return top_k_array_file(input_path, output_path, format, top_k);
+    if (input_path) return sort_array_file(input_path, output_path, format, sort_file_array);
+
+    if (benchmark_size > 0) {
+        run_benchmark(benchmark_size);
+        return 0;
+    }
+    if (top_benchmark_size > 0) {
+        run_top_k_benchmark(top_benchmark_size);
+        return 0;
+    }
 
+    setvbuf(stdin, NULL, _IONBF, 0); // The number prompts read stdin with `read()` (text_reader.h), so stdio must not read ahead
     int choice;
     printf(MAGENTA "Selection Sort\n");
     printf("==============\n" RESET);
     if (visualize) printf(BG_YELLOW "Visualization enabled." RESET "\n");
+    if (double_ended && visualize) printf(YELLOW "Double-ended mode is not visualized, using the single-ended sort.\n" RESET);
+    if (top_k > 0) printf(BG_YELLOW "Top-%d mode enabled." RESET "\n", top_k);
+    if (top_k > 0 && visualize) printf(YELLOW "Top-k mode is not visualized.\n" RESET);
     printf("Choose data type:\n");
     printf("1. Integers\n");
     printf("2. Floats\n");
@@ -40,6 +124,7 @@ int main(int argc, char *argv[]) {
 
     char type = 0;
     void *arr = NULL;
+    char *arena = NULL; // Backing storage of the strings when sorting 's' (`arr` then holds pointers into it)
 
     switch(choice) {
         // For integers
@@ -47,9 +132,12 @@ int main(int argc, char *argv[]) {
             type = 'i';
             arr = malloc(size * sizeof(int));
 
+            text_reader_t reader;
+            text_reader_open(&reader, STDIN_FILENO);
             printf("Enter %d integers: ", size);
-            for (int i = 0; i < size; i++) scanf("%*[^0-9]%d", &((int*)arr)[i]);
-            while (getchar() != '\n'); // Clear input buffer
+            for (int i = 0; i < size; i++) text_reader_int(&reader, &((int*)arr)[i]);
+            text_reader_skip_line(&reader); // Clear input buffer
+            text_reader_close(&reader);
             break;
         }
         // For floats
@@ -57,9 +145,12 @@ int main(int argc, char *argv[]) {
             type = 'f';
             arr = malloc(size * sizeof(float));
 
+            text_reader_t reader;
+            text_reader_open(&reader, STDIN_FILENO);
             printf("Enter %d floats: ", size);
-            for (int i = 0; i < size; i++) scanf("%*[^0-9.]%f", &((float*)arr)[i]);
-            while (getchar() != '\n'); // Clear input buffer
+            for (int i = 0; i < size; i++) text_reader_float(&reader, &((float*)arr)[i]);
+            text_reader_skip_line(&reader); // Clear input buffer
+            text_reader_close(&reader);
             break;
         }
         // For characters
@@ -75,10 +166,9 @@ int main(int argc, char *argv[]) {
         // For strings
         case 4: {
             type = 's';
-            arr = malloc(size * STRING_LENGTH * sizeof(char));
 
             printf("Enter %d strings: ", size);
-            for (int i = 0; i < size; i++) scanf("%s", ((char(*)[STRING_LENGTH])arr)[i]);
+            arr = read_strings(size, &arena);
             while (getchar() != '\n'); // Clear input buffer
             break;
         }
@@ -94,34 +184,92 @@ int main(int argc, char *argv[]) {
     print_array(arr, size, type);
     printf(RESET);
 
+    if (top_k > 0) {
+        int k = top_k < size ? top_k : size;
+        top_k_strategy_t strategy = top_k_strategy(size, k, type);
+        printf(DIM "Selecting the %d smallest (%s)...\n" RESET, k, top_k_names[strategy]);
+        select_top_k(arr, size, k, type, strategy);
+
+        printf(GREEN "\n-- Smallest %d Elements\n" RESET BOLD, k);
+        print_array(arr, k, type);
+        printf(RESET);
+        free(arr);
+        free(arena);
+        return 0;
+    }
+
     printf(DIM "Sorting...\n" RESET);
-    selection_sort(arr, size, type, visualize);
+    if (double_ended && !visualize) selection_sort_double_ended(arr, size, type, active_kernels());
+    else selection_sort(arr, size, type, visualize);
 
     printf(GREEN "\n-- Sorted Array\n" RESET BOLD);
     print_array(arr, size, type);
     printf(RESET);
 
     free(arr);
+    free(arena);
     return 0;
 }
 
 /**
  * Performs selection sort on an array of various types.
  *
+ * Integers and floats are sorted with the fastest argmin kernels the CPU supports (`active_kernels()`);
+ * characters, strings and visualized sorts use `selection_sort_generic()`.
+ *
  * Supported types:
  * - 'i' for int
  * - 'f' for float
  * - 'c' for char
- * - 's' for string (char[STRING_LENGTH]) - `STRING_LENGTH` is defined as 50.
+ * - 's' for string (char*) - pointers into one string arena, strings of any length.
  *
  * @param arr       Pointer to the array to sort.
  * @param size      Number of elements in the array.
  * @param type      Data type of the array elements:
- *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char[STRING_LENGTH]).
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
  * @param visualize Flag to enable step-by-step visualization. (1 = enable, 0 = disable)
  * @return          void
  */
 void selection_sort(void *arr, int size, char type, int visualize) {
+    if (!visualize && sort_network(arr, size, type)) return; // Up to 16 ints or floats: no argmin scans at all
+    if (!visualize && (type == 'i' || type == 'f')) selection_sort_kernel(arr, size, type, active_kernels());
+    else selection_sort_generic(arr, size, type, visualize);
+}
+
+/**
+ * Sorts an array loaded by `--in` with the options from the command line (never visualized).
+ *
+ * @param arr       Pointer to the array to sort.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @return          void
+ */
+void sort_file_array(void *arr, int size, char type) {
+    if (double_ended) selection_sort_double_ended(arr, size, type, active_kernels());
+    else selection_sort(arr, size, type, 0);
+}
+
+/**
+ * Performs selection sort on an array of various types, checking the type for every comparison.
+ *
+ * This is the original implementation, kept for characters, strings, visualization and as the
+ * `--benchmark` baseline.
+ *
+ * Supported types:
+ * - 'i' for int
+ * - 'f' for float
+ * - 'c' for char
+ * - 's' for string (char*) - pointers into one string arena, strings of any length.
+ *
+ * @param arr       Pointer to the array to sort.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @param visualize Flag to enable step-by-step visualization. (1 = enable, 0 = disable)
+ * @return          void
+ */
+void selection_sort_generic(void *arr, int size, char type, int visualize) {
     if (visualize) printf(BOLD "\nStep-by-step sorting:\n" RESET);
 
     for (int i = 0; i < size - 1; i++) {
@@ -137,6 +285,8 @@ void selection_sort(void *arr, int size, char type, int visualize) {
 
             switch (type) {
                 case 'i': // Integer
+                    if (((int*)arr)[j] < ((int*)arr)[min_index]) min_index = j;
+                    break;
                 case 'f': // Float
                     if (((float*)arr)[j] < ((float*)arr)[min_index]) min_index = j;
                     break;
@@ -144,7 +294,7 @@ void selection_sort(void *arr, int size, char type, int visualize) {
                     if (((char*)arr)[j] < ((char*)arr)[min_index]) min_index = j;
                     break;
                 case 's': // String
-                    if (strcmp(((char(*)[STRING_LENGTH])arr)[j], ((char(*)[STRING_LENGTH])arr)[min_index]) < 0) min_index = j;
+                    if (strcmp(((char**)arr)[j], ((char**)arr)[min_index]) < 0) min_index = j;
                     break;
                 default:
                     return; // Unsupported type
@@ -159,7 +309,12 @@ void selection_sort(void *arr, int size, char type, int visualize) {
             if (visualize) printf(GREEN "  ✓ Swapping index %d with index %d\n" RESET, i, min_index);
 
             switch (type) {
-                case 'i':
+                case 'i': {
+                    int temp = ((int*)arr)[i];
+                    ((int*)arr)[i] = ((int*)arr)[min_index];
+                    ((int*)arr)[min_index] = temp;
+                    break;
+                }
                 case 'f': {
                     float temp = ((float*)arr)[i];
                     ((float*)arr)[i] = ((float*)arr)[min_index];
@@ -173,10 +328,9 @@ void selection_sort(void *arr, int size, char type, int visualize) {
                     break;
                 }
                 case 's': {
-                    char temp[STRING_LENGTH];
-                    strcpy(temp, ((char(*)[STRING_LENGTH])arr)[i]);
-                    strcpy(((char(*)[STRING_LENGTH])arr)[i], ((char(*)[STRING_LENGTH])arr)[min_index]);
-                    strcpy(((char(*)[STRING_LENGTH])arr)[min_index], temp);
+                    char *temp = ((char**)arr)[i]; // Swap pointers, the strings stay in the arena
+                    ((char**)arr)[i] = ((char**)arr)[min_index];
+                    ((char**)arr)[min_index] = temp;
                     break;
                 }
                 default:
@@ -194,6 +348,826 @@ void selection_sort(void *arr, int size, char type, int visualize) {
     }
 }
 
+/**
+ * Performs selection sort on ints or floats, finding every minimum with an argmin kernel.
+ *
+ * @param arr       Pointer to the array to sort.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements: 'i' for int, 'f' for float.
+ * @param kernels   Argmin kernels to use (scalar, SSE2 or AVX2).
+ * @return          void
+ */
+void selection_sort_kernel(void *arr, int size, char type, const argmin_kernels_t *kernels) {
+    selection_sort_passes(arr, size, size - 1, type, kernels);
+}
+
+/**
+ * Runs the first `passes` passes of selection sort on ints or floats: afterwards `arr[0..passes)`
+ * holds the `passes` smallest elements in order (the min-scan strategy of `--top K`).
+ *
+ * @param arr       Pointer to the array.
+ * @param size      Number of elements in the array.
+ * @param passes    Number of minima to place (at most `size - 1` are needed for a full sort).
+ * @param type      Data type of the array elements: 'i' for int, 'f' for float.
+ * @param kernels   Argmin kernels to use (scalar, SSE2 or AVX2).
+ * @return          void
+ */
+void selection_sort_passes(void *arr, int size, int passes, char type, const argmin_kernels_t *kernels) {
+    argmin_fn argmin = type == 'i' ? kernels->argmin_int : kernels->argmin_float;
+    int32_t *keys = arr;
+    for (int i = 0; i < passes && i < size - 1; i++) {
+        int min_index = i + argmin(keys + i, size - i);
+        int32_t temp = keys[i]; // Ints and floats are both moved as 32-bit words
+        keys[i] = keys[min_index];
+        keys[min_index] = temp;
+    }
+}
+
+/**
+ * Performs double-ended selection sort: every pass finds the minimum and the maximum of the
+ * unsorted middle and places them at both ends, so only about n / 2 passes are needed.
+ *
+ * Supported types:
+ * - 'i' for int
+ * - 'f' for float
+ * - 'c' for char
+ * - 's' for string (char*) - pointers into one string arena, strings of any length.
+ *
+ * @param arr       Pointer to the array to sort.
+ * @param size      Number of elements in the array.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @param kernels   Argmin kernels used for ints and floats.
+ * @return          void
+ */
+void selection_sort_double_ended(void *arr, int size, char type, const argmin_kernels_t *kernels) {
+    if (sort_network(arr, size, type)) return;
+
+    for (int left = 0, right = size - 1; left < right; left++, right--) {
+        int min_index, max_index;
+        find_min_max(arr, left, right, type, kernels, &min_index, &max_index);
+
+        swap_elements(arr, left, min_index, type);
+        if (max_index == left) max_index = min_index; // The maximum was just moved away from `left`
+        swap_elements(arr, right, max_index, type);
+    }
+}
+
+/**
+ * Finds the indices of the minimum and the maximum of `arr[left..right]` in one pass.
+ *
+ * @param arr       Pointer to the array.
+ * @param left      Starting index of the range.
+ * @param right     Ending index of the range.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @param kernels   Argmin kernels used for ints and floats.
+ * @param min_index Receives the index of the (first) minimum.
+ * @param max_index Receives the index of the (first) maximum.
+ * @return          void
+ */
+void find_min_max(void *arr, int left, int right, char type, const argmin_kernels_t *kernels, int *min_index, int *max_index) {
+    if (type == 'i' || type == 'f') {
+        argminmax_fn argminmax = type == 'i' ? kernels->argminmax_int : kernels->argminmax_float;
+        argminmax((const int32_t*)arr + left, right - left + 1, min_index, max_index);
+        *min_index += left;
+        *max_index += left;
+        return;
+    }
+
+    *min_index = *max_index = left;
+    for (int j = left + 1; j <= right; j++) {
+        switch (type) {
+            case 'c': // Character
+                if (((char*)arr)[j] < ((char*)arr)[*min_index]) *min_index = j;
+                if (((char*)arr)[j] > ((char*)arr)[*max_index]) *max_index = j;
+                break;
+            case 's': // String
+                if (strcmp(((char**)arr)[j], ((char**)arr)[*min_index]) < 0) *min_index = j;
+                if (strcmp(((char**)arr)[j], ((char**)arr)[*max_index]) > 0) *max_index = j;
+                break;
+            default:
+                return; // Unsupported type
+        }
+    }
+}
+
+/**
+ * Swaps two elements of an array of various types.
+ *
+ * @param arr       Pointer to the array.
+ * @param a         Index of the first element.
+ * @param b         Index of the second element.
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @return          void
+ */
+void swap_elements(void *arr, int a, int b, char type) {
+    switch (type) {
+        case 'i':
+        case 'f': {
+            int32_t temp = ((int32_t*)arr)[a]; // Ints and floats are both moved as 32-bit words
+            ((int32_t*)arr)[a] = ((int32_t*)arr)[b];
+            ((int32_t*)arr)[b] = temp;
+            break;
+        }
+        case 'c': {
+            char temp = ((char*)arr)[a];
+            ((char*)arr)[a] = ((char*)arr)[b];
+            ((char*)arr)[b] = temp;
+            break;
+        }
+        case 's': {
+            char *temp = ((char**)arr)[a]; // Swap pointers, the strings stay in the arena
+            ((char**)arr)[a] = ((char**)arr)[b];
+            ((char**)arr)[b] = temp;
+            break;
+        }
+        default:
+            return; // Unsupported type
+    }
+}
+
+// Key transforms: the argmin kernels compare signed 32-bit keys. Ints are their own key; a float's bit
+// pattern becomes an int with the same order by flipping the magnitude bits of negative floats
+// (so -0.0 sorts right before 0.0, and NaNs end up beyond the infinities).
+#define KEY_INT(x) (x)
+#define KEY_FLOAT(x) ((x) ^ (int32_t)((uint32_t)((x) >> 31) >> 1))
+
+/**
+ * Defines the scalar argmin and argmin+argmax kernels for one key transform.
+ *
+ * `name##_argmin(keys, n)` returns the index of the first minimum of `keys[0..n)`;
+ * `name##_argminmax(keys, n, &min, &max)` finds the first minimum and first maximum in one pass.
+ *
+ * @param name      Prefix of the generated functions.
+ * @param key       Scalar key transform, `KEY_INT` or `KEY_FLOAT`.
+ */
+#define DEFINE_SCALAR_ARGMIN(name, key)                                                                                         \
+int name##_argmin(const int32_t *keys, int n) {                                                                                 \
+    int best = 0;                                                                                                               \
+    int32_t best_key = key(keys[0]);                                                                                            \
+    for (int i = 1; i < n; i++) {                                                                                               \
+        int32_t k = key(keys[i]);                                                                                               \
+        best = k < best_key ? i : best;                                                                                         \
+        best_key = k < best_key ? k : best_key;                                                                                 \
+    }                                                                                                                           \
+    return best;                                                                                                                \
+}                                                                                                                               \
+                                                                                                                                \
+void name##_argminmax(const int32_t *keys, int n, int *min_index, int *max_index) {                                             \
+    int lo = 0, hi = 0;                                                                                                         \
+    int32_t lo_key = key(keys[0]), hi_key = lo_key;                                                                             \
+    for (int i = 1; i < n; i++) {                                                                                               \
+        int32_t k = key(keys[i]);                                                                                               \
+        lo = k < lo_key ? i : lo;                                                                                               \
+        lo_key = k < lo_key ? k : lo_key;                                                                                       \
+        hi = k > hi_key ? i : hi;                                                                                               \
+        hi_key = k > hi_key ? k : hi_key;                                                                                       \
+    }                                                                                                                           \
+    *min_index = lo;                                                                                                            \
+    *max_index = hi;                                                                                                            \
+}
+
+DEFINE_SCALAR_ARGMIN(scalar_int, KEY_INT)
+DEFINE_SCALAR_ARGMIN(scalar_float, KEY_FLOAT)
+
+/**
+ * Picks the best of the per-lane results of a SIMD argmin/argmax kernel.
+ *
+ * Every lane holds the first minimum (or maximum) of the elements it saw, so the overall first one
+ * is the lane with the best key and, among equal keys, the smallest index.
+ *
+ * @param lane_keys  Best key of every lane.
+ * @param lane_index Index of the best key of every lane.
+ * @param lanes      Number of lanes.
+ * @param want_max   0 to pick the minimum, 1 to pick the maximum.
+ * @param best_key   Receives the winning key.
+ * @return           Index of the winning element.
+ */
+int reduce_lanes(const int32_t *lane_keys, const int32_t *lane_index, int lanes, int want_max, int32_t *best_key) {
+    int best = 0;
+    for (int lane = 1; lane < lanes; lane++) {
+        int better = want_max ? lane_keys[lane] > lane_keys[best] : lane_keys[lane] < lane_keys[best];
+        if (better || (lane_keys[lane] == lane_keys[best] && lane_index[lane] < lane_index[best])) best = lane;
+    }
+    *best_key = lane_keys[best];
+    return lane_index[best];
+}
+
+#if HAVE_X86_SIMD
+
+// Vector key transforms matching `KEY_INT` / `KEY_FLOAT`
+#define KEY_INT_SSE2(v) (v)
+#define KEY_FLOAT_SSE2(v) _mm_xor_si128((v), _mm_srli_epi32(_mm_srai_epi32((v), 31), 1))
+#define KEY_INT_AVX2(v) (v)
+#define KEY_FLOAT_AVX2(v) _mm256_xor_si256((v), _mm256_srli_epi32(_mm256_srai_epi32((v), 31), 1))
+
+// SSE2 has no blend instruction: select `b` where `mask` is set, else `a`
+#define BLEND_SSE2(a, b, mask) _mm_or_si128(_mm_and_si128((mask), (b)), _mm_andnot_si128((mask), (a)))
+
+/**
+ * Defines the SSE2 argmin and argmin+argmax kernels (4 lanes) for one key transform.
+ *
+ * Each lane keeps its own running minimum and index, updated branchlessly with a compare mask;
+ * `reduce_lanes()` merges the lanes and the last `n % 4` keys are handled by scalar code.
+ *
+ * @param name      Prefix of the generated functions.
+ * @param scalar    Prefix of the scalar kernels used for short ranges (`scalar_int` or `scalar_float`).
+ * @param key       Scalar key transform, `KEY_INT` or `KEY_FLOAT`.
+ * @param vkey      Vector key transform, `KEY_INT_SSE2` or `KEY_FLOAT_SSE2`.
+ */
+#define DEFINE_SSE2_ARGMIN(name, scalar, key, vkey)                                                                             \
+__attribute__((target("sse2"))) int name##_argmin(const int32_t *keys, int n) {                                                 \
+    if (n < 8) return scalar##_argmin(keys, n);                                                                                 \
+    __m128i best = vkey(_mm_loadu_si128((const __m128i*)keys));                                                                 \
+    __m128i best_index = _mm_setr_epi32(0, 1, 2, 3);                                                                            \
+    __m128i index = best_index, step = _mm_set1_epi32(4);                                                                       \
+    int i = 4;                                                                                                                  \
+    for (; i + 4 <= n; i += 4) {                                                                                                \
+        index = _mm_add_epi32(index, step);                                                                                     \
+        __m128i k = vkey(_mm_loadu_si128((const __m128i*)(keys + i)));                                                          \
+        __m128i less = _mm_cmplt_epi32(k, best);                                                                                \
+        best = BLEND_SSE2(best, k, less);                                                                                       \
+        best_index = BLEND_SSE2(best_index, index, less);                                                                       \
+    }                                                                                                                           \
+    int32_t lane_keys[4], lane_index[4], best_key;                                                                              \
+    _mm_storeu_si128((__m128i*)lane_keys, best);                                                                                \
+    _mm_storeu_si128((__m128i*)lane_index, best_index);                                                                         \
+    int result = reduce_lanes(lane_keys, lane_index, 4, 0, &best_key);                                                          \
+    for (; i < n; i++) if (key(keys[i]) < best_key) { best_key = key(keys[i]); result = i; }                                    \
+    return result;                                                                                                              \
+}                                                                                                                               \
+                                                                                                                                \
+__attribute__((target("sse2"))) void name##_argminmax(const int32_t *keys, int n, int *min_index, int *max_index) {             \
+    if (n < 8) {                                                                                                                \
+        scalar##_argminmax(keys, n, min_index, max_index);                                                                      \
+        return;                                                                                                                 \
+    }                                                                                                                           \
+    __m128i lo = vkey(_mm_loadu_si128((const __m128i*)keys)), hi = lo;                                                          \
+    __m128i lo_index = _mm_setr_epi32(0, 1, 2, 3), hi_index = lo_index;                                                         \
+    __m128i index = lo_index, step = _mm_set1_epi32(4);                                                                         \
+    int i = 4;                                                                                                                  \
+    for (; i + 4 <= n; i += 4) {                                                                                                \
+        index = _mm_add_epi32(index, step);                                                                                     \
+        __m128i k = vkey(_mm_loadu_si128((const __m128i*)(keys + i)));                                                          \
+        __m128i less = _mm_cmplt_epi32(k, lo), greater = _mm_cmpgt_epi32(k, hi);                                                \
+        lo = BLEND_SSE2(lo, k, less);                                                                                           \
+        lo_index = BLEND_SSE2(lo_index, index, less);                                                                           \
+        hi = BLEND_SSE2(hi, k, greater);                                                                                        \
+        hi_index = BLEND_SSE2(hi_index, index, greater);                                                                        \
+    }                                                                                                                           \
+    int32_t lane_keys[4], lane_index[4], lo_key, hi_key;                                                                        \
+    _mm_storeu_si128((__m128i*)lane_keys, lo);                                                                                  \
+    _mm_storeu_si128((__m128i*)lane_index, lo_index);                                                                           \
+    *min_index = reduce_lanes(lane_keys, lane_index, 4, 0, &lo_key);                                                            \
+    _mm_storeu_si128((__m128i*)lane_keys, hi);                                                                                  \
+    _mm_storeu_si128((__m128i*)lane_index, hi_index);                                                                           \
+    *max_index = reduce_lanes(lane_keys, lane_index, 4, 1, &hi_key);                                                            \
+    for (; i < n; i++) {                                                                                                        \
+        int32_t k = key(keys[i]);                                                                                               \
+        if (k < lo_key) { lo_key = k; *min_index = i; }                                                                         \
+        if (k > hi_key) { hi_key = k; *max_index = i; }                                                                         \
+    }                                                                                                                           \
+}
+
+/**
+ * Defines the AVX2 argmin and argmin+argmax kernels (8 lanes) for one key transform.
+ *
+ * Same scheme as `DEFINE_SSE2_ARGMIN`, with twice the lanes and `vpblendvb` for the selects.
+ * The functions are compiled for AVX2 only and must not be called on CPUs without it.
+ *
+ * @param name      Prefix of the generated functions.
+ * @param scalar    Prefix of the scalar kernels used for short ranges (`scalar_int` or `scalar_float`).
+ * @param key       Scalar key transform, `KEY_INT` or `KEY_FLOAT`.
+ * @param vkey      Vector key transform, `KEY_INT_AVX2` or `KEY_FLOAT_AVX2`.
+ */
+#define DEFINE_AVX2_ARGMIN(name, scalar, key, vkey)                                                                             \
+__attribute__((target("avx2"))) int name##_argmin(const int32_t *keys, int n) {                                                 \
+    if (n < 16) return scalar##_argmin(keys, n);                                                                                \
+    __m256i best = vkey(_mm256_loadu_si256((const __m256i*)keys));                                                              \
+    __m256i best_index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);                                                             \
+    __m256i index = best_index, step = _mm256_set1_epi32(8);                                                                    \
+    int i = 8;                                                                                                                  \
+    for (; i + 8 <= n; i += 8) {                                                                                                \
+        index = _mm256_add_epi32(index, step);                                                                                  \
+        __m256i k = vkey(_mm256_loadu_si256((const __m256i*)(keys + i)));                                                       \
+        __m256i less = _mm256_cmpgt_epi32(best, k);                                                                             \
+        best = _mm256_blendv_epi8(best, k, less);                                                                               \
+        best_index = _mm256_blendv_epi8(best_index, index, less);                                                               \
+    }                                                                                                                           \
+    int32_t lane_keys[8], lane_index[8], best_key;                                                                              \
+    _mm256_storeu_si256((__m256i*)lane_keys, best);                                                                             \
+    _mm256_storeu_si256((__m256i*)lane_index, best_index);                                                                      \
+    int result = reduce_lanes(lane_keys, lane_index, 8, 0, &best_key);                                                          \
+    for (; i < n; i++) if (key(keys[i]) < best_key) { best_key = key(keys[i]); result = i; }                                    \
+    return result;                                                                                                              \
+}                                                                                                                               \
+                                                                                                                                \
+__attribute__((target("avx2"))) void name##_argminmax(const int32_t *keys, int n, int *min_index, int *max_index) {             \
+    if (n < 16) {                                                                                                               \
+        scalar##_argminmax(keys, n, min_index, max_index);                                                                      \
+        return;                                                                                                                 \
+    }                                                                                                                           \
+    __m256i lo = vkey(_mm256_loadu_si256((const __m256i*)keys)), hi = lo;                                                       \
+    __m256i lo_index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), hi_index = lo_index;                                          \
+    __m256i index = lo_index, step = _mm256_set1_epi32(8);                                                                      \
+    int i = 8;                                                                                                                  \
+    for (; i + 8 <= n; i += 8) {                                                                                                \
+        index = _mm256_add_epi32(index, step);                                                                                  \
+        __m256i k = vkey(_mm256_loadu_si256((const __m256i*)(keys + i)));                                                       \
+        __m256i less = _mm256_cmpgt_epi32(lo, k), greater = _mm256_cmpgt_epi32(k, hi);                                          \
+        lo = _mm256_blendv_epi8(lo, k, less);                                                                                   \
+        lo_index = _mm256_blendv_epi8(lo_index, index, less);                                                                   \
+        hi = _mm256_blendv_epi8(hi, k, greater);                                                                                \
+        hi_index = _mm256_blendv_epi8(hi_index, index, greater);                                                                \
+    }                                                                                                                           \
+    int32_t lane_keys[8], lane_index[8], lo_key, hi_key;                                                                        \
+    _mm256_storeu_si256((__m256i*)lane_keys, lo);                                                                               \
+    _mm256_storeu_si256((__m256i*)lane_index, lo_index);                                                                        \
+    *min_index = reduce_lanes(lane_keys, lane_index, 8, 0, &lo_key);                                                            \
+    _mm256_storeu_si256((__m256i*)lane_keys, hi);                                                                               \
+    _mm256_storeu_si256((__m256i*)lane_index, hi_index);                                                                        \
+    *max_index = reduce_lanes(lane_keys, lane_index, 8, 1, &hi_key);                                                            \
+    for (; i < n; i++) {                                                                                                        \
+        int32_t k = key(keys[i]);                                                                                               \
+        if (k < lo_key) { lo_key = k; *min_index = i; }                                                                         \
+        if (k > hi_key) { hi_key = k; *max_index = i; }                                                                         \
+    }                                                                                                                           \
+}
+
+DEFINE_SSE2_ARGMIN(sse2_int, scalar_int, KEY_INT, KEY_INT_SSE2)
+DEFINE_SSE2_ARGMIN(sse2_float, scalar_float, KEY_FLOAT, KEY_FLOAT_SSE2)
+DEFINE_AVX2_ARGMIN(avx2_int, scalar_int, KEY_INT, KEY_INT_AVX2)
+DEFINE_AVX2_ARGMIN(avx2_float, scalar_float, KEY_FLOAT, KEY_FLOAT_AVX2)
+
+#endif
+
+// Kernel levels, indexed by `cpu_simd_level()`: 0 = scalar, 1 = SSE2, 2 = AVX2
+const argmin_kernels_t kernel_levels[] = {
+    {"Scalar", scalar_int_argmin, scalar_float_argmin, scalar_int_argminmax, scalar_float_argminmax},
+#if HAVE_X86_SIMD
+    {"SSE2", sse2_int_argmin, sse2_float_argmin, sse2_int_argminmax, sse2_float_argminmax},
+    {"AVX2", avx2_int_argmin, avx2_float_argmin, avx2_int_argminmax, avx2_float_argminmax},
+#endif
+};
+
+/**
+ * Returns the highest argmin kernel level this CPU can run (runtime CPU dispatch).
+ *
+ * @return          0 for scalar, 1 for SSE2, 2 for AVX2.
+ */
+int cpu_simd_level(void) {
+#if HAVE_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return 2;
+    if (__builtin_cpu_supports("sse2")) return 1;
+#endif
+    return 0;
+}
+
+/**
+ * Returns the fastest argmin kernels this CPU supports. The CPU is queried on the first call only;
+ * later calls return the cached level.
+ *
+ * @return          Pointer into `kernel_levels`.
+ */
+const argmin_kernels_t *active_kernels(void) {
+    static const argmin_kernels_t *kernels = NULL;
+    if (!kernels) kernels = &kernel_levels[cpu_simd_level()];
+    return kernels;
+}
+
+// Strict comparisons of the top-k kernels
+#define NUMBER_LESS(a, b) ((a) < (b))
+#define STRING_LESS(a, b) (strcmp((a), (b)) < 0)
+
+/**
+ * Defines the top-k kernels for one element type.
+ *
+ * - `name##_heap_select(arr, size, k)`: bounded max-heap of the k smallest so far in `arr[0..k)`;
+ *   every later element costs one comparison with the heap top, and a smaller one replaces it.
+ *   The heap is heap-sorted at the end. O(n log k), the best choice while k is small.
+ * - `name##_introselect(arr, left, right, nth)`: quickselect with a ninther pivot and a three-way
+ *   partition (runs of equal keys end the search early). Once the partitions have touched more than
+ *   `TOP_K_SELECT_BUDGET` times the range, it switches to median-of-medians pivots, which bounds the
+ *   worst case to O(n).
+ * - `name##_select_top(arr, size, k)`: introselect around index k - 1, then heap-sort `arr[0..k)`.
+ *   O(n + k log k).
+ *
+ * Every kernel only swaps elements, so `arr` stays a permutation of its input.
+ *
+ * @param name      Prefix of the generated functions.
+ * @param T         Element type.
+ * @param less      Strict comparison macro `less(a, b)`.
+ */
+#define DEFINE_TOP_K_KERNELS(name, T, less)                                                                                     \
+void name##_introselect(T *arr, int left, int right, int nth);                                                                  \
+                                                                                                                                \
+void name##_sift_down(T *heap, int size, int root) {                                                                            \
+    T value = heap[root];                                                                                                       \
+    while (1) {                                                                                                                 \
+        int child = 2 * root + 1;                                                                                               \
+        if (child >= size) break;                                                                                               \
+        if (child + 1 < size && less(heap[child], heap[child + 1])) child++;                                                    \
+        if (!less(value, heap[child])) break;                                                                                   \
+        heap[root] = heap[child];                                                                                               \
+        root = child;                                                                                                           \
+    }                                                                                                                           \
+    heap[root] = value;                                                                                                         \
+}                                                                                                                               \
+                                                                                                                                \
+void name##_heap_select(T *arr, int size, int k) {                                                                              \
+    for (int i = k / 2 - 1; i >= 0; i--) name##_sift_down(arr, k, i);                                                           \
+    for (int i = k; i < size; i++) {                                                                                            \
+        if (!less(arr[i], arr[0])) continue; /* Not below the largest kept element */                                           \
+        T temp = arr[i];                                                                                                        \
+        arr[i] = arr[0];                                                                                                        \
+        arr[0] = temp;                                                                                                          \
+        name##_sift_down(arr, k, 0);                                                                                            \
+    }                                                                                                                           \
+    for (int end = k - 1; end > 0; end--) {                                                                                     \
+        T temp = arr[end];                                                                                                      \
+        arr[end] = arr[0];                                                                                                      \
+        arr[0] = temp;                                                                                                          \
+        name##_sift_down(arr, end, 0);                                                                                          \
+    }                                                                                                                           \
+}                                                                                                                               \
+                                                                                                                                \
+void name##_insertion_sort(T *arr, int left, int right) {                                                                       \
+    for (int i = left + 1; i <= right; i++) {                                                                                   \
+        T value = arr[i];                                                                                                       \
+        int j = i - 1;                                                                                                          \
+        while (j >= left && less(value, arr[j])) {                                                                              \
+            arr[j + 1] = arr[j];                                                                                                \
+            j--;                                                                                                                \
+        }                                                                                                                       \
+        arr[j + 1] = value;                                                                                                     \
+    }                                                                                                                           \
+}                                                                                                                               \
+                                                                                                                                \
+T name##_median_of_3(T a, T b, T c) {                                                                                           \
+    return less(a, b) ? (less(b, c) ? b : less(a, c) ? c : a) : (less(a, c) ? a : less(b, c) ? c : b);                          \
+}                                                                                                                               \
+                                                                                                                                \
+/* Pivot with a guaranteed 30/70 split: medians of groups of 5, then their median (selected recursively) */                     \
+T name##_median_of_medians(T *arr, int left, int right) {                                                                       \
+    int count = 0;                                                                                                              \
+    for (int group = left; group <= right; group += 5) {                                                                        \
+        int end = group + 4 < right ? group + 4 : right;                                                                        \
+        name##_insertion_sort(arr, group, end);                                                                                 \
+        int median = group + (end - group) / 2;                                                                                 \
+        T temp = arr[left + count];                                                                                             \
+        arr[left + count] = arr[median];                                                                                        \
+        arr[median] = temp;                                                                                                     \
+        count++;                                                                                                                \
+    }                                                                                                                           \
+    name##_introselect(arr, left, left + count - 1, left + count / 2);                                                          \
+    return arr[left + count / 2];                                                                                               \
+}                                                                                                                               \
+                                                                                                                                \
+void name##_introselect(T *arr, int left, int right, int nth) {                                                                 \
+    int median_of_medians = 0;                                                                                                  \
+    long long work = 0, budget = (long long)TOP_K_SELECT_BUDGET * (right - left + 1);                                           \
+    while (right - left + 1 >= TOP_K_INSERTION_CUTOFF) {                                                                        \
+        T pivot;                                                                                                                \
+        if (median_of_medians) pivot = name##_median_of_medians(arr, left, right);                                              \
+        else {                                                                                                                  \
+            int step = (right - left) / 8, middle = left + (right - left) / 2;                                                  \
+            pivot = name##_median_of_3(arr[left], arr[middle], arr[right]);                                                     \
+            if (step > 0) /* Ninther: median of three medians of 3, robust against unlucky samples */                           \
+                pivot = name##_median_of_3(name##_median_of_3(arr[left], arr[left + step], arr[left + 2 * step]), pivot,        \
+                                           name##_median_of_3(arr[right - 2 * step], arr[right - step], arr[right]));           \
+        }                                                                                                                       \
+                                                                                                                                \
+        /* Three-way partition: [left, lt) < pivot, [lt, gt] == pivot, (gt, right] > pivot */                                   \
+        int lt = left, i = left, gt = right;                                                                                    \
+        while (i <= gt) {                                                                                                       \
+            T value = arr[i];                                                                                                   \
+            if (less(value, pivot)) {                                                                                           \
+                arr[i++] = arr[lt];                                                                                             \
+                arr[lt++] = value;                                                                                              \
+            } else if (less(pivot, value)) {                                                                                    \
+                arr[i] = arr[gt];                                                                                               \
+                arr[gt--] = value;                                                                                              \
+            } else i++;                                                                                                         \
+        }                                                                                                                       \
+        if (nth < lt) right = lt - 1;                                                                                           \
+        else if (nth > gt) left = gt + 1;                                                                                       \
+        else return;                                                                                                            \
+                                                                                                                                \
+        /* Work budget: quickselect touches about 2n elements; past the budget the pivots are bad */                            \
+        work += right - left + 1;                                                                                               \
+        if (work > budget) median_of_medians = 1;                                                                               \
+    }                                                                                                                           \
+    name##_insertion_sort(arr, left, right);                                                                                    \
+}                                                                                                                               \
+                                                                                                                                \
+void name##_select_top(T *arr, int size, int k) {                                                                               \
+    name##_introselect(arr, 0, size - 1, k - 1);                                                                                \
+    name##_heap_select(arr, k, k); /* Heap sort of the k smallest */                                                            \
+}
+
+DEFINE_TOP_K_KERNELS(top_k_int, int, NUMBER_LESS)
+DEFINE_TOP_K_KERNELS(top_k_float, float, NUMBER_LESS)
+DEFINE_TOP_K_KERNELS(top_k_char, char, NUMBER_LESS)
+DEFINE_TOP_K_KERNELS(top_k_string, char*, STRING_LESS)
+
+/**
+ * Picks the fastest way to find the k smallest of `size` elements.
+ *
+ * A few argmin passes (ints and floats) are cheapest for tiny k; the bounded heap rejects most
+ * elements with one comparison while k is a small fraction of the array; beyond that introselect's
+ * O(n) partitioning wins.
+ *
+ * @param size      Number of elements in the array.
+ * @param k         Number of smallest elements wanted (1 to `size`).
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @return          `TOP_K_SCAN`, `TOP_K_HEAP` or `TOP_K_SELECT`.
+ */
+top_k_strategy_t top_k_strategy(int size, int k, char type) {
+    if ((type == 'i' || type == 'f') && k <= TOP_K_SCAN_MAX) return TOP_K_SCAN;
+    if (k <= size / TOP_K_HEAP_DIVISOR) return TOP_K_HEAP;
+    return TOP_K_SELECT;
+}
+
+/**
+ * Moves the k smallest elements of an array, in ascending order, to `arr[0..k)`.
+ *
+ * The rest of the array keeps the other elements in unspecified order.
+ *
+ * Supported types:
+ * - 'i' for int
+ * - 'f' for float
+ * - 'c' for char
+ * - 's' for string (char*) - pointers into one string arena, strings of any length.
+ *
+ * @param arr       Pointer to the array.
+ * @param size      Number of elements in the array.
+ * @param k         Number of smallest elements wanted (clamped to 0..`size`).
+ * @param type      Data type of the array elements:
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
+ * @param strategy  `TOP_K_SCAN` (ints and floats only, else the heap is used), `TOP_K_HEAP` or
+ *                      `TOP_K_SELECT`; usually `top_k_strategy()`.
+ * @return          void
+ */
+void select_top_k(void *arr, int size, int k, char type, top_k_strategy_t strategy) {
+    if (k > size) k = size;
+    if (k <= 0) return;
+    if (strategy == TOP_K_SCAN && (type == 'i' || type == 'f')) {
+        selection_sort_passes(arr, size, k, type, active_kernels());
+        return;
+    }
+
+    int heap = strategy != TOP_K_SELECT;
+    switch (type) {
+        case 'i': heap ? top_k_int_heap_select(arr, size, k) : top_k_int_select_top(arr, size, k); break;
+        case 'f': heap ? top_k_float_heap_select(arr, size, k) : top_k_float_select_top(arr, size, k); break;
+        case 'c': heap ? top_k_char_heap_select(arr, size, k) : top_k_char_select_top(arr, size, k); break;
+        case 's': heap ? top_k_string_heap_select(arr, size, k) : top_k_string_select_top(arr, size, k); break;
+        default: return; // Unsupported type
+    }
+}
+
+/**
+ * Loads an array file, finds its k smallest elements and writes only those, in order (`--in` with
+ * `--top K`). The phase timings go to stderr.
+ *
+ * @param input_path  File to read.
+ * @param output_path Output file, NULL or "-" for stdout.
+ * @param format      "i32", "f32", "u8" or "lines".
+ * @param k           Number of smallest elements to write.
+ * @return            0 on success, 1 on error.
+ */
+int top_k_array_file(const char *input_path, const char *output_path, const char *format, int k) {
+    char type = array_file_type(format);
+    if (!type) {
+        fprintf(stderr, "--in needs --format i32, f32, u8 or lines!\n");
+        return 1;
+    }
+
+    array_file_t file;
+    int size;
+    double start = array_file_seconds();
+    void *arr = array_file_load(&file, input_path, type, &size);
+    if (!arr) return 1;
+    double load_time = array_file_seconds() - start;
+
+    if (k > size) k = size;
+    top_k_strategy_t strategy = top_k_strategy(size, k, type);
+    start = array_file_seconds();
+    select_top_k(arr, size, k, type, strategy);
+    double select_time = array_file_seconds() - start;
+
+    start = array_file_seconds();
+    int status = array_file_write(output_path, arr, k, type);
+    double write_time = array_file_seconds() - start;
+    array_file_close(&file);
+
+    if (status == 0)
+        fprintf(stderr, "%d smallest of %d elements (%s, %s): load %.3f s, select %.3f s, write %.3f s\n", k, size, format,
+                top_k_names[strategy], load_time, select_time, write_time);
+    return status;
+}
+
+// `qsort()` comparators used to check the benchmark results
+int compare_int(const void *a, const void *b) { return (*(const int*)a > *(const int*)b) - (*(const int*)a < *(const int*)b); }
+int compare_float(const void *a, const void *b) { return (*(const float*)a > *(const float*)b) - (*(const float*)a < *(const float*)b); }
+
+/**
+ * Benchmarks the argmin kernels against the generic selection sort loop on random ints and floats.
+ *
+ * Array sizes go from 64 up to `max_size` (times 4 per row). Every cell sorts a copy of the same
+ * input repeatedly (about `BENCHMARK_COMPARISONS` comparisons) and reports the time per sort; the
+ * last result of every method is compared with `qsort()`.
+ *
+ * @param max_size  Largest array size.
+ * @return          void
+ */
+void run_benchmark(int max_size) {
+    const char types[] = {'i', 'f'};
+    const char *names[] = {"Integers", "Floats"};
+    int levels = cpu_simd_level() + 1;
+
+    printf(MAGENTA "Selection Sort Benchmark\n");
+    printf("========================\n" RESET);
+    printf("Argmin kernels available: ");
+    for (int level = 0; level < levels; level++) printf("%s%s", kernel_levels[level].name, level + 1 < levels ? ", " : "\n");
+    printf("Time per sort in microseconds, speedup of the best single-ended kernel over generic\n");
+
+    srand(42); // Fixed seed so runs are comparable
+    for (int t = 0; t < 2; t++) {
+        printf(BOLD "\n%-10s %11s %11s %11s %11s %13s %9s   %s\n" RESET, names[t], "Generic", "Scalar", "SSE2", "AVX2", "Double-ended", "Speedup", "vs qsort");
+
+        for (int size = 64; size <= max_size; size *= 4) {
+            int32_t *input = malloc(size * sizeof(int32_t));
+            int32_t *work = malloc(size * sizeof(int32_t));
+            int32_t *reference = malloc(size * sizeof(int32_t));
+            for (int i = 0; i < size; i++) {
+                if (types[t] == 'i') input[i] = rand() - RAND_MAX / 2;
+                else ((float*)input)[i] = (float)rand() / RAND_MAX * 2000.0f - 1000.0f;
+            }
+            memcpy(reference, input, size * sizeof(int32_t));
+            qsort(reference, size, sizeof(int32_t), types[t] == 'i' ? compare_int : compare_float);
+
+            long long repetitions = BENCHMARK_COMPARISONS / ((long long)size * size / 2);
+            if (repetitions < 1) repetitions = 1;
+
+            // Methods: 0 = generic, 1..3 = single-ended kernel levels, 4 = double-ended with the active level
+            double times[5] = {0};
+            int ok = 1;
+            for (int method = 0; method < 5; method++) {
+                if (method >= 1 && method <= 3 && method - 1 >= levels) continue;
+
+                double start = now_seconds();
+                for (long long r = 0; r < repetitions; r++) {
+                    memcpy(work, input, size * sizeof(int32_t));
+                    if (method == 0) selection_sort_generic(work, size, types[t], 0);
+                    else if (method <= 3) selection_sort_kernel(work, size, types[t], &kernel_levels[method - 1]);
+                    else selection_sort_double_ended(work, size, types[t], active_kernels());
+                }
+                times[method] = (now_seconds() - start) / repetitions * 1e6;
+                if (memcmp(work, reference, size * sizeof(int32_t)) != 0) ok = 0;
+            }
+
+            printf("%-10d %11.2f", size, times[0]);
+            for (int method = 1; method <= 3; method++) {
+                if (times[method] > 0) printf(" %11.2f", times[method]);
+                else printf(" %11s", "n/a");
+            }
+            double best = times[levels];
+            printf(" %13.2f %8.2fx   ", times[4], best > 0 ? times[0] / best : 0.0);
+            printf(ok ? GREEN "✓ match" RESET "\n" : RED "✗ MISMATCH" RESET "\n");
+
+            free(input);
+            free(work);
+            free(reference);
+        }
+    }
+}
+
+/**
+ * Benchmarks the top-k strategies against a full `qsort()` on `size` ints and floats.
+ *
+ * Inputs are random ints and floats plus adversarial int patterns (sorted, reversed, all equal,
+ * organ pipe) that break naive quickselect pivots. Every row is one k; the min-scan column only
+ * runs for small k (it is O(n k)). Each result's prefix is compared with the `qsort()` prefix, and
+ * the last column names the strategy `top_k_strategy()` would pick.
+ *
+ * @param size      Array size.
+ * @return          void
+ */
+void run_top_k_benchmark(int size) {
+    const char *inputs[] = {"Random ints", "Random floats", "Sorted", "Reversed", "All equal", "Organ pipe"};
+    const int input_count = sizeof(inputs) / sizeof(inputs[0]);
+    int ks[] = {1, 4, 16, 100, 1000, size / 1000, size / 100, size / 10, size / 2};
+    const int k_count = sizeof(ks) / sizeof(ks[0]);
+
+    printf(MAGENTA "Top-k Selection Benchmark\n");
+    printf("=========================\n" RESET);
+    printf("%d elements, time per selection in milliseconds\n", size);
+
+    int32_t *input = malloc(size * sizeof(int32_t));
+    int32_t *work = malloc(size * sizeof(int32_t));
+    int32_t *reference = malloc(size * sizeof(int32_t));
+    srand(42); // Fixed seed so runs are comparable
+    for (int p = 0; p < input_count; p++) {
+        char type = p == 1 ? 'f' : 'i';
+        for (int i = 0; i < size; i++) {
+            switch (p) {
+                case 0: input[i] = rand() - RAND_MAX / 2; break;
+                case 1: ((float*)input)[i] = (float)rand() / RAND_MAX * 2000.0f - 1000.0f; break;
+                case 2: input[i] = i; break;
+                case 3: input[i] = size - i; break;
+                case 4: input[i] = 7; break;
+                default: input[i] = i < size / 2 ? i : size - i; break;
+            }
+        }
+        memcpy(reference, input, size * sizeof(int32_t));
+        double start = now_seconds();
+        qsort(reference, size, sizeof(int32_t), type == 'i' ? compare_int : compare_float);
+        double qsort_time = (now_seconds() - start) * 1e3;
+
+        printf(BOLD "\n%-14s %11s %11s %11s %11s   %-13s %s\n" RESET, inputs[p], "Min-scan", "Heap", "Introselect", "qsort", "Picked", "vs qsort");
+        for (int r = 0; r < k_count; r++) {
+            int k = ks[r];
+            if (k < 1 || k > size || (r > 0 && k <= ks[r - 1])) continue;
+
+            double times[TOP_K_STRATEGY_COUNT] = {0};
+            int ok = 1;
+            for (int strategy = 0; strategy < TOP_K_STRATEGY_COUNT; strategy++) {
+                if (strategy == TOP_K_SCAN && k > 16) continue; // Quadratic-ish, only worth timing for tiny k
+                memcpy(work, input, size * sizeof(int32_t));
+                start = now_seconds();
+                select_top_k(work, size, k, type, strategy);
+                times[strategy] = (now_seconds() - start) * 1e3;
+                if (memcmp(work, reference, k * sizeof(int32_t)) != 0) ok = 0;
+            }
+
+            printf("k = %-10d", k);
+            for (int strategy = 0; strategy < TOP_K_STRATEGY_COUNT; strategy++) {
+                if (times[strategy] > 0) printf(" %11.3f", times[strategy]);
+                else printf(" %11s", "n/a");
+            }
+            printf(" %11.3f   %-13s ", qsort_time, top_k_names[top_k_strategy(size, k, type)]);
+            printf(ok ? GREEN "✓ match" RESET "\n" : RED "✗ MISMATCH" RESET "\n");
+        }
+    }
+    free(input);
+    free(work);
+    free(reference);
+}
+
+/**
+ * Returns a monotonic timestamp in seconds, used for benchmark timing.
+ *
+ * @return          Current monotonic time in seconds.
+ */
+double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Reads whitespace-separated strings of any length from standard input into one arena.
+ *
+ * All characters are appended back to back (each string NUL-terminated) to a single growing buffer,
+ * and the returned array holds one pointer per string into it. Sorting then only moves pointers.
+ * The character that ends the last string is pushed back, so the caller can still clear the line.
+ *
+ * @param size      Number of strings to read.
+ * @param arena     Receives the arena holding the characters. Free it after the pointer array.
+ * @return          Array of `size` pointers into the arena.
+ */
+char **read_strings(int size, char **arena) {
+    size_t capacity = 256, used = 0;
+    size_t *offsets = malloc(size * sizeof(size_t)); // Offsets, because the arena may move while growing
+    *arena = malloc(capacity);
+
+    int c = EOF;
+    for (int i = 0; i < size; i++) {
+        c = getchar();
+        while (c != EOF && isspace(c)) c = getchar();
+
+        offsets[i] = used;
+        while (1) {
+            if (used + 1 >= capacity) *arena = realloc(*arena, capacity *= 2);
+            if (c == EOF || isspace(c)) break;
+            (*arena)[used++] = (char)c;
+            c = getchar();
+        }
+        (*arena)[used++] = '\0';
+    }
+    if (c != EOF) ungetc(c, stdin);
+
+    char **strings = malloc(size * sizeof(char*));
+    for (int i = 0; i < size; i++) strings[i] = *arena + offsets[i];
+    free(offsets);
+    return strings;
+}
+
 /**
  * Prints an array of various types without highlighting.
  *
@@ -201,12 +1175,12 @@ void selection_sort(void *arr, int size, char type, int visualize) {
  * - 'i' for int
  * - 'f' for float
  * - 'c' for char
- * - 's' for string (char[STRING_LENGTH]) - `STRING_LENGTH` is defined as 50.
+ * - 's' for string (char*) - pointers into one string arena, strings of any length.
  *
  * @param arr       Pointer to the array to print.
  * @param size      Number of elements in the array.
  * @param type      Data type of the array elements:
- *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char[STRING_LENGTH]).
+ *                      'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
  * @return          void
  */
 void print_array(void *arr, int size, char type) {
@@ -220,12 +1194,12 @@ void print_array(void *arr, int size, char type) {
  * - 'i' for int
  * - 'f' for float
  * - 'c' for char
- * - 's' for string (char[STRING_LENGTH]) - `STRING_LENGTH` is defined as 50.
+ * - 's' for string (char*) - pointers into one string arena, strings of any length.
  *
  * @param arr               Pointer to the array to print.
  * @param size              Number of elements in the array.
  * @param type              Data type of the array elements:
- *                              'i' for int, 'f' for float, 'c' for char, 's' for string (char[STRING_LENGTH]).
+ *                              'i' for int, 'f' for float, 'c' for char, 's' for string (char*).
  * @param sorted_boundary   Index marking the boundary between sorted and unsorted portions (-1 for no highlight).
  * @param current           Index of the current element being compared (-1 for no highlight).
  * @param min_index         Index of the current minimum element (-1 for no highlight).
@@ -250,7 +1224,7 @@ void print_array_with_highlight(void *arr, int size, char type, int sorted_bound
                 printf("'%c'", ((char *)arr)[i]);
                 break;
             case 's':
-                printf("\"%s\"", ((char (*)[STRING_LENGTH])arr)[i]);
+                printf("\"%s\"", ((char**)arr)[i]);
                 break;
             default:
                 printf("Unknown type");